@@ -0,0 +1,142 @@
+// Gerado por tools/makefsdata.py a partir de web/; não edite à mão.
+
+#include "lwip/apps/fs.h"
+#include "lwip/def.h"
+
+// /404.html: 170 bytes na origem, 281 na flash
+static const unsigned char data__404_html[] = {
+0x2f,0x34,0x30,0x34,0x2e,0x68,0x74,0x6d,0x6c,0x00,
+0x48,0x54,0x54,0x50,0x2f,0x31,0x2e,0x30,0x20,0x34,0x30,0x34,0x20,0x46,0x69,0x6c,
+0x65,0x20,0x6e,0x6f,0x74,0x20,0x66,0x6f,0x75,0x6e,0x64,0x0d,0x0a,0x53,0x65,0x72,
+0x76,0x65,0x72,0x3a,0x20,0x6c,0x77,0x49,0x50,0x2f,0x70,0x69,0x63,0x6f,0x0d,0x0a,
+0x43,0x6f,0x6e,0x74,0x65,0x6e,0x74,0x2d,0x54,0x79,0x70,0x65,0x3a,0x20,0x74,0x65,
+0x78,0x74,0x2f,0x68,0x74,0x6d,0x6c,0x3b,0x20,0x63,0x68,0x61,0x72,0x73,0x65,0x74,
+0x3d,0x55,0x54,0x46,0x2d,0x38,0x0d,0x0a,0x43,0x6f,0x6e,0x74,0x65,0x6e,0x74,0x2d,
+0x4c,0x65,0x6e,0x67,0x74,0x68,0x3a,0x20,0x31,0x37,0x30,0x0d,0x0a,0x0d,0x0a,0x3c,
+0x21,0x44,0x4f,0x43,0x54,0x59,0x50,0x45,0x20,0x68,0x74,0x6d,0x6c,0x3e,0x0a,0x3c,
+0x68,0x74,0x6d,0x6c,0x3e,0x0a,0x3c,0x68,0x65,0x61,0x64,0x3e,0x3c,0x6d,0x65,0x74,
+0x61,0x20,0x63,0x68,0x61,0x72,0x73,0x65,0x74,0x3d,0x22,0x55,0x54,0x46,0x2d,0x38,
+0x22,0x3e,0x3c,0x74,0x69,0x74,0x6c,0x65,0x3e,0x34,0x30,0x34,0x3c,0x2f,0x74,0x69,
+0x74,0x6c,0x65,0x3e,0x3c,0x2f,0x68,0x65,0x61,0x64,0x3e,0x0a,0x3c,0x62,0x6f,0x64,
+0x79,0x3e,0x3c,0x68,0x31,0x3e,0x50,0xc3,0xa1,0x67,0x69,0x6e,0x61,0x20,0x6e,0xc3,
+0xa3,0x6f,0x20,0x65,0x6e,0x63,0x6f,0x6e,0x74,0x72,0x61,0x64,0x61,0x3c,0x2f,0x68,
+0x31,0x3e,0x3c,0x70,0x3e,0x3c,0x61,0x20,0x68,0x72,0x65,0x66,0x3d,0x22,0x2f,0x22,
+0x3e,0x56,0x6f,0x6c,0x74,0x61,0x72,0x20,0x61,0x6f,0x20,0x70,0x61,0x69,0x6e,0x65,
+0x6c,0x3c,0x2f,0x61,0x3e,0x3c,0x2f,0x70,0x3e,0x3c,0x2f,0x62,0x6f,0x64,0x79,0x3e,
+0x0a,0x3c,0x2f,0x68,0x74,0x6d,0x6c,0x3e,0x0a,
+};
+
+// /index.shtml: 912 bytes na origem, 923 na flash
+static const unsigned char data__index_shtml[] = {
+0x2f,0x69,0x6e,0x64,0x65,0x78,0x2e,0x73,0x68,0x74,0x6d,0x6c,0x00,
+0x3c,0x21,0x44,0x4f,0x43,0x54,0x59,0x50,0x45,0x20,0x68,0x74,0x6d,0x6c,0x3e,0x0a,
+0x3c,0x68,0x74,0x6d,0x6c,0x3e,0x0a,0x3c,0x68,0x65,0x61,0x64,0x3e,0x0a,0x3c,0x6d,
+0x65,0x74,0x61,0x20,0x63,0x68,0x61,0x72,0x73,0x65,0x74,0x3d,0x22,0x55,0x54,0x46,
+0x2d,0x38,0x22,0x3e,0x0a,0x3c,0x74,0x69,0x74,0x6c,0x65,0x3e,0x50,0x61,0x69,0x6e,
+0x65,0x6c,0x20,0x43,0x61,0x73,0x61,0x20,0x49,0x6e,0x74,0x65,0x6c,0x69,0x67,0x65,
+0x6e,0x74,0x65,0x3c,0x2f,0x74,0x69,0x74,0x6c,0x65,0x3e,0x0a,0x3c,0x6c,0x69,0x6e,
+0x6b,0x20,0x72,0x65,0x6c,0x3d,0x22,0x69,0x63,0x6f,0x6e,0x22,0x20,0x68,0x72,0x65,
+0x66,0x3d,0x22,0x64,0x61,0x74,0x61,0x3a,0x2c,0x22,0x3e,0x0a,0x3c,0x6c,0x69,0x6e,
+0x6b,0x20,0x72,0x65,0x6c,0x3d,0x22,0x73,0x74,0x79,0x6c,0x65,0x73,0x68,0x65,0x65,
+0x74,0x22,0x20,0x68,0x72,0x65,0x66,0x3d,0x22,0x2f,0x73,0x74,0x79,0x6c,0x65,0x2e,
+0x63,0x73,0x73,0x3f,0x76,0x3d,0x63,0x39,0x63,0x39,0x63,0x32,0x61,0x66,0x22,0x3e,
+0x0a,0x3c,0x2f,0x68,0x65,0x61,0x64,0x3e,0x0a,0x3c,0x62,0x6f,0x64,0x79,0x3e,0x0a,
+0x3c,0x68,0x31,0x3e,0x50,0x61,0x69,0x6e,0x65,0x6c,0x20,0x43,0x61,0x73,0x61,0x20,
+0x49,0x6e,0x74,0x65,0x6c,0x69,0x67,0x65,0x6e,0x74,0x65,0x3c,0x2f,0x68,0x31,0x3e,
+0x0a,0x3c,0x66,0x6f,0x72,0x6d,0x20,0x61,0x63,0x74,0x69,0x6f,0x6e,0x3d,0x22,0x2f,
+0x6c,0x65,0x64,0x5f,0x6f,0x6e,0x22,0x3e,0x3c,0x62,0x75,0x74,0x74,0x6f,0x6e,0x3e,
+0x4c,0x69,0x67,0x61,0x72,0x20,0x4c,0x45,0x44,0x3c,0x2f,0x62,0x75,0x74,0x74,0x6f,
+0x6e,0x3e,0x3c,0x2f,0x66,0x6f,0x72,0x6d,0x3e,0x0a,0x3c,0x66,0x6f,0x72,0x6d,0x20,
+0x61,0x63,0x74,0x69,0x6f,0x6e,0x3d,0x22,0x2f,0x6c,0x65,0x64,0x5f,0x6f,0x66,0x66,
+0x22,0x3e,0x3c,0x62,0x75,0x74,0x74,0x6f,0x6e,0x3e,0x44,0x65,0x73,0x6c,0x69,0x67,
+0x61,0x72,0x20,0x4c,0x45,0x44,0x3c,0x2f,0x62,0x75,0x74,0x74,0x6f,0x6e,0x3e,0x3c,
+0x2f,0x66,0x6f,0x72,0x6d,0x3e,0x0a,0x3c,0x66,0x6f,0x72,0x6d,0x20,0x61,0x63,0x74,
+0x69,0x6f,0x6e,0x3d,0x22,0x2f,0x63,0x6f,0x6c,0x6f,0x72,0x5f,0x72,0x65,0x64,0x22,
+0x3e,0x3c,0x62,0x75,0x74,0x74,0x6f,0x6e,0x3e,0x56,0x65,0x72,0x6d,0x65,0x6c,0x68,
+0x6f,0x3c,0x2f,0x62,0x75,0x74,0x74,0x6f,0x6e,0x3e,0x3c,0x2f,0x66,0x6f,0x72,0x6d,
+0x3e,0x0a,0x3c,0x66,0x6f,0x72,0x6d,0x20,0x61,0x63,0x74,0x69,0x6f,0x6e,0x3d,0x22,
+0x2f,0x63,0x6f,0x6c,0x6f,0x72,0x5f,0x67,0x72,0x65,0x65,0x6e,0x22,0x3e,0x3c,0x62,
+0x75,0x74,0x74,0x6f,0x6e,0x3e,0x56,0x65,0x72,0x64,0x65,0x3c,0x2f,0x62,0x75,0x74,
+0x74,0x6f,0x6e,0x3e,0x3c,0x2f,0x66,0x6f,0x72,0x6d,0x3e,0x0a,0x3c,0x66,0x6f,0x72,
+0x6d,0x20,0x61,0x63,0x74,0x69,0x6f,0x6e,0x3d,0x22,0x2f,0x63,0x6f,0x6c,0x6f,0x72,
+0x5f,0x62,0x6c,0x75,0x65,0x22,0x3e,0x3c,0x62,0x75,0x74,0x74,0x6f,0x6e,0x3e,0x41,
+0x7a,0x75,0x6c,0x3c,0x2f,0x62,0x75,0x74,0x74,0x6f,0x6e,0x3e,0x3c,0x2f,0x66,0x6f,
+0x72,0x6d,0x3e,0x0a,0x3c,0x66,0x6f,0x72,0x6d,0x20,0x61,0x63,0x74,0x69,0x6f,0x6e,
+0x3d,0x22,0x2f,0x63,0x6f,0x6c,0x6f,0x72,0x5f,0x79,0x65,0x6c,0x6c,0x6f,0x77,0x22,
+0x3e,0x3c,0x62,0x75,0x74,0x74,0x6f,0x6e,0x3e,0x41,0x6d,0x61,0x72,0x65,0x6c,0x6f,
+0x3c,0x2f,0x62,0x75,0x74,0x74,0x6f,0x6e,0x3e,0x3c,0x2f,0x66,0x6f,0x72,0x6d,0x3e,
+0x0a,0x3c,0x66,0x6f,0x72,0x6d,0x20,0x61,0x63,0x74,0x69,0x6f,0x6e,0x3d,0x22,0x2f,
+0x63,0x6f,0x6c,0x6f,0x72,0x5f,0x63,0x79,0x61,0x6e,0x22,0x3e,0x3c,0x62,0x75,0x74,
+0x74,0x6f,0x6e,0x3e,0x43,0x69,0x61,0x6e,0x6f,0x3c,0x2f,0x62,0x75,0x74,0x74,0x6f,
+0x6e,0x3e,0x3c,0x2f,0x66,0x6f,0x72,0x6d,0x3e,0x0a,0x3c,0x66,0x6f,0x72,0x6d,0x20,
+0x61,0x63,0x74,0x69,0x6f,0x6e,0x3d,0x22,0x2f,0x63,0x6f,0x6c,0x6f,0x72,0x5f,0x6c,
+0x69,0x6c,0x61,0x73,0x22,0x3e,0x3c,0x62,0x75,0x74,0x74,0x6f,0x6e,0x3e,0x4c,0x69,
+0x6c,0xc3,0xa1,0x73,0x3c,0x2f,0x62,0x75,0x74,0x74,0x6f,0x6e,0x3e,0x3c,0x2f,0x66,
+0x6f,0x72,0x6d,0x3e,0x0a,0x3c,0x66,0x6f,0x72,0x6d,0x20,0x61,0x63,0x74,0x69,0x6f,
+0x6e,0x3d,0x22,0x2f,0x61,0x6c,0x61,0x72,0x6d,0x5f,0x6f,0x66,0x66,0x22,0x3e,0x3c,
+0x62,0x75,0x74,0x74,0x6f,0x6e,0x3e,0x44,0x65,0x73,0x6c,0x69,0x67,0x61,0x72,0x20,
+0x41,0x6c,0x61,0x72,0x6d,0x65,0x3c,0x2f,0x62,0x75,0x74,0x74,0x6f,0x6e,0x3e,0x3c,
+0x2f,0x66,0x6f,0x72,0x6d,0x3e,0x0a,0x3c,0x70,0x20,0x63,0x6c,0x61,0x73,0x73,0x3d,
+0x73,0x3e,0x4c,0x45,0x44,0x3a,0x20,0x3c,0x21,0x2d,0x2d,0x23,0x6c,0x65,0x64,0x2d,
+0x2d,0x3e,0x3c,0x2f,0x70,0x3e,0x0a,0x3c,0x70,0x20,0x63,0x6c,0x61,0x73,0x73,0x3d,
+0x73,0x3e,0x43,0x6f,0x72,0x3a,0x20,0x3c,0x21,0x2d,0x2d,0x23,0x63,0x6f,0x72,0x2d,
+0x2d,0x3e,0x3c,0x2f,0x70,0x3e,0x0a,0x3c,0x70,0x20,0x63,0x6c,0x61,0x73,0x73,0x3d,
+0x73,0x3e,0x54,0x65,0x6d,0x70,0x65,0x72,0x61,0x74,0x75,0x72,0x61,0x3a,0x20,0x3c,
+0x21,0x2d,0x2d,0x23,0x74,0x65,0x6d,0x70,0x2d,0x2d,0x3e,0x43,0x3c,0x2f,0x70,0x3e,
+0x0a,0x3c,0x70,0x20,0x63,0x6c,0x61,0x73,0x73,0x3d,0x73,0x3e,0x45,0x6d,0x65,0x72,
+0x67,0xc3,0xaa,0x6e,0x63,0x69,0x61,0x3a,0x20,0x3c,0x21,0x2d,0x2d,0x23,0x65,0x6d,
+0x65,0x72,0x67,0x2d,0x2d,0x3e,0x3c,0x2f,0x70,0x3e,0x0a,0x3c,0x2f,0x62,0x6f,0x64,
+0x79,0x3e,0x0a,0x3c,0x2f,0x68,0x74,0x6d,0x6c,0x3e,0x0a,
+};
+
+// /style.css: 174 bytes na origem, 316 na flash
+static const unsigned char data__style_css[] = {
+0x2f,0x73,0x74,0x79,0x6c,0x65,0x2e,0x63,0x73,0x73,0x00,
+0x48,0x54,0x54,0x50,0x2f,0x31,0x2e,0x30,0x20,0x32,0x30,0x30,0x20,0x4f,0x4b,0x0d,
+0x0a,0x53,0x65,0x72,0x76,0x65,0x72,0x3a,0x20,0x6c,0x77,0x49,0x50,0x2f,0x70,0x69,
+0x63,0x6f,0x0d,0x0a,0x43,0x6f,0x6e,0x74,0x65,0x6e,0x74,0x2d,0x54,0x79,0x70,0x65,
+0x3a,0x20,0x74,0x65,0x78,0x74,0x2f,0x63,0x73,0x73,0x0d,0x0a,0x43,0x6f,0x6e,0x74,
+0x65,0x6e,0x74,0x2d,0x45,0x6e,0x63,0x6f,0x64,0x69,0x6e,0x67,0x3a,0x20,0x67,0x7a,
+0x69,0x70,0x0d,0x0a,0x43,0x6f,0x6e,0x74,0x65,0x6e,0x74,0x2d,0x4c,0x65,0x6e,0x67,
+0x74,0x68,0x3a,0x20,0x31,0x33,0x39,0x0d,0x0a,0x43,0x61,0x63,0x68,0x65,0x2d,0x43,
+0x6f,0x6e,0x74,0x72,0x6f,0x6c,0x3a,0x20,0x70,0x75,0x62,0x6c,0x69,0x63,0x2c,0x20,
+0x6d,0x61,0x78,0x2d,0x61,0x67,0x65,0x3d,0x33,0x31,0x35,0x33,0x36,0x30,0x30,0x30,
+0x2c,0x20,0x69,0x6d,0x6d,0x75,0x74,0x61,0x62,0x6c,0x65,0x0d,0x0a,0x45,0x54,0x61,
+0x67,0x3a,0x20,0x22,0x63,0x39,0x63,0x39,0x63,0x32,0x61,0x66,0x22,0x0d,0x0a,0x0d,
+0x0a,0x1f,0x8b,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0x75,0x8c,0x39,0x0e,0xc2,
+0x30,0x10,0x00,0x7b,0x7f,0x83,0xda,0x88,0x00,0x6e,0xec,0x8a,0xa7,0xf8,0x66,0x85,
+0xb3,0x1b,0x39,0x1b,0x29,0x09,0xf2,0xdf,0x31,0x82,0x82,0x86,0x6e,0x34,0x1a,0x8d,
+0xa3,0xb0,0x3d,0x13,0x21,0xcb,0x64,0x47,0x28,0x9b,0xbe,0x55,0xb0,0xc5,0x70,0x5c,
+0x59,0xda,0x02,0x19,0xb5,0x8f,0xc8,0xb1,0x9a,0xd1,0xd6,0x0c,0xa8,0x87,0xd3,0xb4,
+0x1a,0x67,0xfd,0x23,0x57,0x5a,0x30,0x48,0x4f,0x85,0xaa,0x3e,0x38,0x15,0x55,0x72,
+0x4d,0xdc,0x87,0xcf,0x6c,0x86,0x3d,0xea,0x6b,0x6f,0x9b,0x70,0x0b,0x33,0xe1,0x8f,
+0xbe,0x9c,0xfb,0xe2,0xbb,0x53,0x1d,0x27,0x1b,0x02,0x60,0x7e,0x73,0x13,0xc7,0xf9,
+0x7f,0xd9,0xc4,0x0b,0xaf,0xc2,0xc9,0xc9,0xae,0x00,0x00,0x00,
+};
+
+static const struct fsdata_file file__404_html[] = {{
+    NULL,
+    data__404_html,
+    data__404_html + 10,
+    sizeof(data__404_html) - 10,
+    FS_FILE_FLAGS_HEADER_INCLUDED | FS_FILE_FLAGS_HEADER_PERSISTENT,
+}};
+
+static const struct fsdata_file file__index_shtml[] = {{
+    file__404_html,
+    data__index_shtml,
+    data__index_shtml + 13,
+    sizeof(data__index_shtml) - 13,
+    FS_FILE_FLAGS_SSI,
+}};
+
+static const struct fsdata_file file__style_css[] = {{
+    file__index_shtml,
+    data__style_css,
+    data__style_css + 11,
+    sizeof(data__style_css) - 11,
+    FS_FILE_FLAGS_HEADER_INCLUDED | FS_FILE_FLAGS_HEADER_PERSISTENT,
+}};
+
+#define FS_ROOT file__style_css
+#define FS_NUMFILES 3
@@ -0,0 +1,208 @@
+#include <string.h>
+#include "config_log.h"
+
+#define CONFIG_MAGICO 0x47464350u // "PCFG"
+#define CHAVE_LIVRE 0xFF          // flash apagada: fim dos registros
+
+typedef struct {
+    uint32_t magico;
+    uint32_t geracao;
+    uint16_t crc;
+    uint16_t reservado;
+} cabecalho_setor_t;
+
+#define REGISTRO_CABECALHO 4 // chave, tamanho e CRC-16
+#define INICIO_REGISTROS sizeof(cabecalho_setor_t)
+
+// CRC-16/CCITT com tabela de 4 bits (sem tabela de 512 bytes na flash)
+static uint16_t crc16(uint16_t crc, const uint8_t *dados, uint32_t tamanho) {
+    static const uint16_t tabela[16] = {
+        0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+        0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+    };
+    for (uint32_t i = 0; i < tamanho; i++) {
+        crc = (uint16_t)((crc << 4) ^ tabela[(crc >> 12) ^ (dados[i] >> 4)]);
+        crc = (uint16_t)((crc << 4) ^ tabela[(crc >> 12) ^ (dados[i] & 0x0F)]);
+    }
+    return crc;
+}
+
+static uint16_t crc_registro(uint8_t chave, uint8_t tamanho, const uint8_t *valor) {
+    uint8_t cabecalho[2] = {chave, tamanho};
+    return crc16(crc16(0xFFFF, cabecalho, 2), valor, tamanho);
+}
+
+static uint16_t crc_cabecalho(const cabecalho_setor_t *cabecalho) {
+    return crc16(0xFFFF, (const uint8_t *)cabecalho, 8);
+}
+
+static uint32_t tamanho_registro(uint8_t tamanho) {
+    return REGISTRO_CABECALHO + ((tamanho + 3u) & ~3u); // mantém registros alinhados a 4 bytes
+}
+
+// percorre o setor ativo carregando o valor mais recente de cada chave
+static void ler_registros(config_log_t *log) {
+    const uint8_t *setor = log->flash.ler(log->flash.ctx, (uint32_t)log->setor_ativo * log->flash.tamanho_setor);
+    uint32_t posicao = INICIO_REGISTROS;
+    while (posicao + REGISTRO_CABECALHO <= log->flash.tamanho_setor) {
+        const uint8_t *registro = setor + posicao;
+        uint8_t chave = registro[0];
+        uint8_t tamanho = registro[1];
+        if (chave == CHAVE_LIVRE) {
+            break;
+        }
+        uint32_t total = tamanho_registro(tamanho);
+        uint16_t crc = (uint16_t)(registro[2] | (registro[3] << 8));
+        if (chave >= CONFIG_MAX_CHAVES || tamanho > CONFIG_VALOR_MAX ||
+            posicao + total > log->flash.tamanho_setor ||
+            crc != crc_registro(chave, tamanho, registro + REGISTRO_CABECALHO)) {
+            log->compactar = true; // gravação interrompida: não acrescenta depois dela
+            break;
+        }
+        memcpy(log->valores[chave], registro + REGISTRO_CABECALHO, tamanho);
+        log->tamanhos[chave] = tamanho;
+        log->presentes |= 1u << chave;
+        log->registros_lidos++;
+        posicao += total;
+    }
+    log->livre = posicao;
+}
+
+void config_log_abrir(config_log_t *log, const memoria_flash_t *flash) {
+    memset(log, 0, sizeof(*log));
+    log->flash = *flash;
+    log->setor_ativo = -1;
+    for (uint32_t i = 0; i < flash->num_setores; i++) {
+        cabecalho_setor_t cabecalho;
+        memcpy(&cabecalho, flash->ler(flash->ctx, i * flash->tamanho_setor), sizeof(cabecalho));
+        if (cabecalho.magico != CONFIG_MAGICO || cabecalho.crc != crc_cabecalho(&cabecalho)) {
+            continue;
+        }
+        if (log->setor_ativo < 0 || (int32_t)(cabecalho.geracao - log->geracao) > 0) {
+            log->setor_ativo = (int32_t)i;
+            log->geracao = cabecalho.geracao;
+        }
+    }
+    if (log->setor_ativo >= 0) {
+        ler_registros(log);
+    }
+}
+
+int config_log_ler(const config_log_t *log, uint8_t chave, void *destino, uint8_t capacidade) {
+    if (chave >= CONFIG_MAX_CHAVES || !(log->presentes & (1u << chave))) {
+        return -1;
+    }
+    uint8_t tamanho = log->tamanhos[chave] < capacidade ? log->tamanhos[chave] : capacidade;
+    memcpy(destino, log->valores[chave], tamanho);
+    return tamanho;
+}
+
+int config_log_tamanho(const config_log_t *log, uint8_t chave) {
+    if (chave >= CONFIG_MAX_CHAVES || !(log->presentes & (1u << chave))) {
+        return -1;
+    }
+    return log->tamanhos[chave];
+}
+
+// altera o valor em RAM; retorna true se ele mudou e ficou pendente de gravação
+bool config_log_definir(config_log_t *log, uint8_t chave, const void *valor, uint8_t tamanho) {
+    if (chave >= CONFIG_MAX_CHAVES || tamanho > CONFIG_VALOR_MAX) {
+        return false;
+    }
+    uint32_t bit = 1u << chave;
+    if ((log->presentes & bit) && log->tamanhos[chave] == tamanho &&
+        memcmp(log->valores[chave], valor, tamanho) == 0) {
+        return false; // mesmo valor: nada a gravar
+    }
+    memcpy(log->valores[chave], valor, tamanho);
+    log->tamanhos[chave] = tamanho;
+    log->presentes |= bit;
+    log->pendentes |= bit;
+    return true;
+}
+
+bool config_log_pendente(const config_log_t *log) {
+    return log->pendentes != 0;
+}
+
+// serializa as chaves da máscara em log->lote e retorna o tamanho
+static uint32_t montar_lote(config_log_t *log, uint32_t mascara) {
+    uint32_t tamanho_lote = 0;
+    for (uint8_t chave = 0; chave < CONFIG_MAX_CHAVES; chave++) {
+        if (!(mascara & (1u << chave))) {
+            continue;
+        }
+        uint8_t tamanho = log->tamanhos[chave];
+        uint8_t *registro = log->lote + tamanho_lote;
+        uint32_t total = tamanho_registro(tamanho);
+        uint16_t crc = crc_registro(chave, tamanho, log->valores[chave]);
+        memset(registro, 0xFF, total);
+        registro[0] = chave;
+        registro[1] = tamanho;
+        registro[2] = (uint8_t)crc;
+        registro[3] = (uint8_t)(crc >> 8);
+        memcpy(registro + REGISTRO_CABECALHO, log->valores[chave], tamanho);
+        tamanho_lote += total;
+    }
+    return tamanho_lote;
+}
+
+// programa um trecho qualquer completando as páginas com 0xFF (bits não tocados)
+static void gravar_bytes(config_log_t *log, uint32_t deslocamento, const uint8_t *dados, uint32_t tamanho) {
+    uint32_t pagina = log->flash.tamanho_pagina;
+    uint32_t fim = deslocamento + tamanho;
+    for (uint32_t inicio = deslocamento - deslocamento % pagina; inicio < fim; inicio += pagina) {
+        uint32_t de = inicio > deslocamento ? inicio : deslocamento;
+        uint32_t ate = inicio + pagina < fim ? inicio + pagina : fim;
+        memset(log->pagina, 0xFF, pagina);
+        memcpy(log->pagina + (de - inicio), dados + (de - deslocamento), ate - de);
+        log->flash.programar(log->flash.ctx, inicio, log->pagina, pagina);
+    }
+}
+
+// copia os valores atuais para o próximo setor, que passa a ser o ativo
+static bool compactar(config_log_t *log) {
+    uint32_t tamanho_lote = montar_lote(log, log->presentes);
+    if (INICIO_REGISTROS + tamanho_lote > log->flash.tamanho_setor) {
+        return false;
+    }
+    uint32_t setor = log->setor_ativo < 0 ? 0 : ((uint32_t)log->setor_ativo + 1) % log->flash.num_setores;
+    uint32_t base = setor * log->flash.tamanho_setor;
+    log->flash.apagar_setor(log->flash.ctx, base);
+    gravar_bytes(log, base + INICIO_REGISTROS, log->lote, tamanho_lote);
+
+    cabecalho_setor_t cabecalho = {CONFIG_MAGICO, log->geracao + 1, 0, 0xFFFF};
+    cabecalho.crc = crc_cabecalho(&cabecalho);
+    gravar_bytes(log, base, (const uint8_t *)&cabecalho, sizeof(cabecalho)); // por último: valida o setor
+
+    log->setor_ativo = (int32_t)setor;
+    log->geracao = cabecalho.geracao;
+    log->livre = INICIO_REGISTROS + tamanho_lote;
+    log->compactar = false;
+    log->compactacoes++;
+    return true;
+}
+
+// grava as chaves pendentes num único lote, compactando se o setor ativo lotou
+bool config_log_gravar(config_log_t *log) {
+    if (!log->pendentes) {
+        return true;
+    }
+    if (log->setor_ativo >= 0 && !log->compactar) {
+        uint32_t tamanho_lote = montar_lote(log, log->pendentes);
+        if (log->livre + tamanho_lote <= log->flash.tamanho_setor) {
+            uint32_t base = (uint32_t)log->setor_ativo * log->flash.tamanho_setor;
+            gravar_bytes(log, base + log->livre, log->lote, tamanho_lote);
+            log->livre += tamanho_lote;
+            log->pendentes = 0;
+            log->gravacoes++;
+            return true;
+        }
+    }
+    if (!compactar(log)) {
+        return false;
+    }
+    log->pendentes = 0;
+    log->gravacoes++;
+    return true;
+}
@@ -0,0 +1,57 @@
+#ifndef CONFIG_LOG_H
+#define CONFIG_LOG_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Log de configurações só de acréscimo sobre alguns setores de flash. Cada
+// gravação acrescenta registros chave/valor com CRC ao setor ativo; ao lotar,
+// os valores atuais são compactados no próximo setor (rodízio entre todos os
+// setores para distribuir o desgaste) e o cabeçalho com a nova geração é
+// gravado por último, de modo que uma queda de energia no meio deixa o setor
+// anterior válido. Os valores ficam em RAM: definir só marca a chave como
+// pendente e várias alterações seguidas viram um único registro.
+//
+// Não depende do SDK: o acesso à flash vem de memoria_flash_t, e o mesmo
+// código roda no RP2040 e sobre uma flash simulada no computador.
+
+#define CONFIG_MAX_CHAVES 8
+#define CONFIG_VALOR_MAX 64
+#define CONFIG_PAGINA_MAX 256
+
+typedef struct {
+    uint32_t tamanho_setor;   // unidade de apagamento
+    uint32_t tamanho_pagina;  // unidade de programação (até CONFIG_PAGINA_MAX)
+    uint32_t num_setores;     // pelo menos 2
+    // deslocamentos relativos ao início da área do log
+    const uint8_t *(*ler)(void *ctx, uint32_t deslocamento); // leitura mapeada em memória
+    void (*apagar_setor)(void *ctx, uint32_t deslocamento);
+    void (*programar)(void *ctx, uint32_t deslocamento, const uint8_t *dados, uint32_t tamanho); // página inteira; bits só vão de 1 para 0
+    void *ctx;
+} memoria_flash_t;
+
+typedef struct {
+    memoria_flash_t flash;
+    int32_t setor_ativo;      // -1 enquanto nenhum setor válido existir
+    uint32_t geracao;         // geração do setor ativo
+    uint32_t livre;           // próximo registro dentro do setor ativo
+    bool compactar;           // registro danificado: a próxima gravação começa outro setor
+    uint8_t valores[CONFIG_MAX_CHAVES][CONFIG_VALOR_MAX];
+    uint8_t tamanhos[CONFIG_MAX_CHAVES];
+    uint32_t presentes;       // chaves com valor (bit por chave)
+    uint32_t pendentes;       // chaves alteradas ainda não gravadas
+    uint32_t registros_lidos; // registros percorridos na abertura
+    uint32_t gravacoes;
+    uint32_t compactacoes;
+    uint8_t pagina[CONFIG_PAGINA_MAX];
+    uint8_t lote[CONFIG_MAX_CHAVES * (4 + CONFIG_VALOR_MAX)];
+} config_log_t;
+
+void config_log_abrir(config_log_t *log, const memoria_flash_t *flash);
+int config_log_ler(const config_log_t *log, uint8_t chave, void *destino, uint8_t capacidade);
+int config_log_tamanho(const config_log_t *log, uint8_t chave); // tamanho guardado, sem truncar; -1 se ausente
+bool config_log_definir(config_log_t *log, uint8_t chave, const void *valor, uint8_t tamanho);
+bool config_log_pendente(const config_log_t *log);
+bool config_log_gravar(config_log_t *log);
+
+#endif
@@ -0,0 +1,194 @@
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "config_painel.h"
+#include "config_log.h"
+#include "hardware/flash.h"
+#include "pico/flash.h"
+
+#define CONFIG_SETORES 4 // 16 KB no fim da flash, em rodízio
+#define CONFIG_INICIO_FLASH (PICO_FLASH_SIZE_BYTES - CONFIG_SETORES * FLASH_SECTOR_SIZE)
+#define ESPERA_GRAVACAO_MS 2000      // grava depois desse tempo sem novas alterações
+#define ATRASO_MAX_GRAVACAO_MS 10000 // alterações contínuas não adiam a gravação além disso
+
+enum { CHAVE_COR, CHAVE_LIGADO, CHAVE_LIMITE, CHAVE_SSID, CHAVE_SENHA, CHAVE_COLETOR, CHAVE_TELEMETRIA };
+
+typedef struct {
+    uint32_t deslocamento;
+    const uint8_t *dados;
+} operacao_flash_t;
+
+static config_log_t log_config;
+static config_painel_t config;
+static uint32_t tempo_restauracao_us;
+static uint32_t primeira_alteracao;
+static uint32_t ultima_alteracao;
+
+static const uint8_t *ler_flash(void *ctx, uint32_t deslocamento) {
+    return (const uint8_t *)(XIP_BASE + CONFIG_INICIO_FLASH + deslocamento); // leitura direta via XIP
+}
+
+// executadas com interrupções desligadas: o XIP fica indisponível durante a operação
+static void apagar_sem_xip(void *param) {
+    const operacao_flash_t *operacao = param;
+    flash_range_erase(CONFIG_INICIO_FLASH + operacao->deslocamento, FLASH_SECTOR_SIZE);
+}
+
+static void programar_sem_xip(void *param) {
+    const operacao_flash_t *operacao = param;
+    flash_range_program(CONFIG_INICIO_FLASH + operacao->deslocamento, operacao->dados, FLASH_PAGE_SIZE);
+}
+
+static void executar(void (*funcao)(void *), operacao_flash_t *operacao) {
+    int resultado = flash_safe_execute(funcao, operacao, 1000);
+    if (resultado != PICO_OK) {
+        printf("Config: falha ao acessar a flash (%d)\n", resultado);
+    }
+}
+
+static void apagar_flash(void *ctx, uint32_t deslocamento) {
+    operacao_flash_t operacao = {deslocamento, NULL};
+    executar(apagar_sem_xip, &operacao);
+}
+
+static void programar_flash(void *ctx, uint32_t deslocamento, const uint8_t *dados, uint32_t tamanho) {
+    operacao_flash_t operacao = {deslocamento, dados};
+    executar(programar_sem_xip, &operacao);
+}
+
+static const memoria_flash_t flash_config = {
+    .tamanho_setor = FLASH_SECTOR_SIZE,
+    .tamanho_pagina = FLASH_PAGE_SIZE,
+    .num_setores = CONFIG_SETORES,
+    .ler = ler_flash,
+    .apagar_setor = apagar_flash,
+    .programar = programar_flash,
+};
+
+// lê um valor de tamanho fixo só se o gravado tiver exatamente esse tamanho
+static bool ler_exato(uint8_t chave, void *destino, uint8_t tamanho) {
+    return config_log_tamanho(&log_config, chave) == tamanho &&
+           config_log_ler(&log_config, chave, destino, tamanho) == tamanho;
+}
+
+static void ler_texto(uint8_t chave, char *destino, uint8_t capacidade) {
+    int tamanho = config_log_ler(&log_config, chave, destino, capacidade);
+    if (tamanho >= 0) {
+        destino[tamanho] = '\0';
+    }
+}
+
+// altera a chave em RAM e marca o início/fim da rajada de alterações
+static void alterar(uint8_t chave, const void *valor, uint8_t tamanho) {
+    bool havia_pendencia = config_log_pendente(&log_config);
+    if (!config_log_definir(&log_config, chave, valor, tamanho)) {
+        return;
+    }
+    uint32_t agora = to_ms_since_boot(get_absolute_time());
+    if (!havia_pendencia) {
+        primeira_alteracao = agora; // primeira alteração desde a última gravação
+    }
+    ultima_alteracao = agora;
+}
+
+void config_painel_init(const config_painel_t *padrao) {
+    config = *padrao;
+    uint64_t inicio = time_us_64();
+    config_log_abrir(&log_config, &flash_config);
+    uint8_t byte;
+    if (config_log_ler(&log_config, CHAVE_COR, &byte, 1) == 1 && byte <= LILAS) {
+        config.cor = (Cor)byte;
+    }
+    if (config_log_ler(&log_config, CHAVE_LIGADO, &byte, 1) == 1) {
+        config.led_ligado = byte != 0;
+    }
+    float limite;
+    if (ler_exato(CHAVE_LIMITE, &limite, sizeof(limite)) && config_painel_limite_valido(limite)) {
+        config.limite_temperatura = limite; // tamanho errado, nan/inf ou fora da faixa mantém o padrão
+    }
+    ler_texto(CHAVE_SSID, config.ssid, CONFIG_SSID_MAX);
+    ler_texto(CHAVE_SENHA, config.senha, CONFIG_SENHA_MAX);
+    uint8_t coletor[6]; // IP seguido da porta
+    if (ler_exato(CHAVE_COLETOR, coletor, sizeof(coletor))) {
+        memcpy(&config.coletor_ip, coletor, 4);
+        memcpy(&config.coletor_porta, coletor + 4, 2);
+    }
+    ler_exato(CHAVE_TELEMETRIA, &config.telemetria_intervalo_ms, sizeof(config.telemetria_intervalo_ms));
+    tempo_restauracao_us = (uint32_t)(time_us_64() - inicio);
+}
+
+const config_painel_t *config_painel(void) {
+    return &config;
+}
+
+void config_painel_definir_cor(Cor cor) {
+    config.cor = cor;
+    uint8_t valor = (uint8_t)cor;
+    alterar(CHAVE_COR, &valor, 1);
+}
+
+void config_painel_definir_ligado(bool ligado) {
+    config.led_ligado = ligado;
+    uint8_t valor = ligado;
+    alterar(CHAVE_LIGADO, &valor, 1);
+}
+
+bool config_painel_limite_valido(float graus) {
+    return isfinite(graus) && graus >= CONFIG_LIMITE_MIN && graus <= CONFIG_LIMITE_MAX;
+}
+
+void config_painel_definir_limite(float graus) {
+    config.limite_temperatura = graus;
+    alterar(CHAVE_LIMITE, &graus, sizeof(graus));
+}
+
+void config_painel_definir_ssid(const char *ssid) {
+    strncpy(config.ssid, ssid, CONFIG_SSID_MAX);
+    config.ssid[CONFIG_SSID_MAX] = '\0';
+    alterar(CHAVE_SSID, config.ssid, (uint8_t)strlen(config.ssid));
+}
+
+void config_painel_definir_senha(const char *senha) {
+    strncpy(config.senha, senha, CONFIG_SENHA_MAX);
+    config.senha[CONFIG_SENHA_MAX] = '\0';
+    alterar(CHAVE_SENHA, config.senha, (uint8_t)strlen(config.senha));
+}
+
+void config_painel_definir_coletor(uint32_t ip, uint16_t porta) {
+    config.coletor_ip = ip;
+    config.coletor_porta = porta;
+    uint8_t coletor[6];
+    memcpy(coletor, &ip, 4);
+    memcpy(coletor + 4, &porta, 2);
+    alterar(CHAVE_COLETOR, coletor, sizeof(coletor));
+}
+
+void config_painel_definir_telemetria(uint32_t intervalo_ms) {
+    config.telemetria_intervalo_ms = intervalo_ms;
+    alterar(CHAVE_TELEMETRIA, &intervalo_ms, sizeof(intervalo_ms));
+}
+
+// grava as alterações pendentes quando a rajada termina (ou já, se imediato)
+void config_painel_persistir(uint32_t agora, bool imediato) {
+    if (!config_log_pendente(&log_config)) {
+        return;
+    }
+    if (!imediato && agora - ultima_alteracao < ESPERA_GRAVACAO_MS &&
+        agora - primeira_alteracao < ATRASO_MAX_GRAVACAO_MS) {
+        return;
+    }
+    if (!config_log_gravar(&log_config)) {
+        printf("Config: falha ao gravar configuracoes\n");
+    }
+}
+
+uint32_t config_painel_tempo_restauracao_us(void) {
+    return tempo_restauracao_us;
+}
+
+void config_painel_relatorio(void) {
+    printf("Config: %lu gravacoes, %lu compactacoes, setor %ld (geracao %lu), %lu bytes livres\n",
+           (unsigned long)log_config.gravacoes, (unsigned long)log_config.compactacoes,
+           (long)log_config.setor_ativo, (unsigned long)log_config.geracao,
+           (unsigned long)(log_config.setor_ativo < 0 ? 0 : FLASH_SECTOR_SIZE - log_config.livre));
+}
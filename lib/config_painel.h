@@ -0,0 +1,45 @@
+#ifndef CONFIG_PAINEL_H
+#define CONFIG_PAINEL_H
+
+#include "pico/stdlib.h"
+#include "estado.h"
+
+// Configurações persistentes do painel (cor, LED, limite de temperatura,
+// credenciais Wi-Fi e coletor de telemetria) guardadas no log de config_log
+// nos últimos setores da flash. As alterações ficam em RAM e são gravadas em
+// lote depois de um intervalo sem novas alterações, então uma sequência de
+// toques nos botões gera uma única gravação.
+
+#define CONFIG_SSID_MAX 32
+#define CONFIG_SENHA_MAX 64
+#define CONFIG_LIMITE_MIN 20.0f // faixa aceita para o limite de temperatura (°C);
+#define CONFIG_LIMITE_MAX 90.0f // fora dela a emergência dispararia sempre ou nunca
+
+typedef struct {
+    Cor cor;
+    bool led_ligado;
+    float limite_temperatura;          // °C acima dos quais a emergência dispara
+    char ssid[CONFIG_SSID_MAX + 1];
+    char senha[CONFIG_SENHA_MAX + 1];
+    uint32_t coletor_ip;               // ordem de bytes do lwIP; 0 desliga a telemetria
+    uint16_t coletor_porta;
+    uint32_t telemetria_intervalo_ms;
+} config_painel_t;
+
+void config_painel_init(const config_painel_t *padrao);
+const config_painel_t *config_painel(void);
+
+void config_painel_definir_cor(Cor cor);
+void config_painel_definir_ligado(bool ligado);
+bool config_painel_limite_valido(float graus);
+void config_painel_definir_limite(float graus);
+void config_painel_definir_ssid(const char *ssid);
+void config_painel_definir_senha(const char *senha);
+void config_painel_definir_coletor(uint32_t ip, uint16_t porta);
+void config_painel_definir_telemetria(uint32_t intervalo_ms);
+
+void config_painel_persistir(uint32_t agora, bool imediato);
+uint32_t config_painel_tempo_restauracao_us(void);
+void config_painel_relatorio(void);
+
+#endif
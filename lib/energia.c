@@ -0,0 +1,126 @@
+#include <stdio.h>
+#include "energia.h"
+#include "pico/cyw43_arch.h"
+
+typedef struct {
+    uint32_t amostras;
+    uint32_t maior_us;
+    uint64_t soma_us;
+} latencia_t;
+
+static const uint32_t cadencia_ms[] = {ENERGIA_PASSADA_ATIVO_MS, ENERGIA_PASSADA_ECONOMIA_MS};
+static const char *nomes_modo[] = {"ativo", "economia"};
+
+static modo_energia_t modo = MODO_ATIVO;
+static int8_t modo_radio = -1; // modo aplicado ao rádio; -1 enquanto o link não está de pé
+static uint32_t ultima_atualizacao;
+
+// escritos pelas IRQs
+static volatile bool evento_pendente;
+static volatile uint32_t ultima_atividade_ms; // última requisição HTTP (0 no boot: começa ativo)
+static volatile bool aguardando_resposta[2];
+static volatile uint32_t instante_evento_us[2];
+static volatile uint8_t modo_evento[2];
+
+static uint32_t despertares[2];
+static uint32_t tempo_ms[2];
+static latencia_t latencias[2][2]; // [modo][origem]
+
+void energia_evento(origem_evento_t origem) {
+    if (!aguardando_resposta[origem]) { // repiques e rajadas medem a partir do primeiro
+        instante_evento_us[origem] = time_us_32();
+        modo_evento[origem] = (uint8_t)modo;
+        aguardando_resposta[origem] = true;
+    }
+    if (origem == ORIGEM_HTTP) {
+        energia_atividade_rede();
+    }
+    evento_pendente = true; // a saída da IRQ já tira a CPU do WFE
+}
+
+void energia_acordar(void) {
+    evento_pendente = true;
+}
+
+void energia_atividade_rede(void) {
+    ultima_atividade_ms = to_ms_since_boot(get_absolute_time());
+    evento_pendente = true; // volta ao modo ativo sem esperar a cadência de economia
+}
+
+modo_energia_t energia_atualizar(uint32_t agora, bool wifi_conectado) {
+    tempo_ms[modo] += agora - ultima_atualizacao;
+    ultima_atualizacao = agora;
+
+    modo_energia_t novo = agora - ultima_atividade_ms < ENERGIA_CLIENTE_INATIVO_MS ? MODO_ATIVO : MODO_ECONOMIA;
+    if (novo != modo) {
+        modo = novo;
+        printf("Energia: modo %s\n", nomes_modo[modo]);
+    }
+
+    if (!wifi_conectado) {
+        modo_radio = -1; // reaplica ao reconectar
+    } else if (modo_radio != (int8_t)modo) {
+        cyw43_arch_lwip_begin();
+        cyw43_wifi_pm(&cyw43_state, modo == MODO_ATIVO ? CYW43_PERFORMANCE_PM : CYW43_AGGRESSIVE_PM); // cyw43_pm_value não é constante
+        cyw43_arch_lwip_end();
+        modo_radio = (int8_t)modo;
+    }
+    return modo;
+}
+
+void energia_concluir(origem_evento_t origem, bool respondido) {
+    if (!aguardando_resposta[origem]) {
+        return;
+    }
+    if (respondido) {
+        uint32_t duracao = time_us_32() - instante_evento_us[origem];
+        latencia_t *latencia = &latencias[modo_evento[origem]][origem];
+        latencia->amostras++;
+        latencia->soma_us += duracao;
+        if (duracao > latencia->maior_us) {
+            latencia->maior_us = duracao;
+        }
+    }
+    aguardando_resposta[origem] = false;
+}
+
+void energia_aguardar(uint32_t agora, uint32_t proxima_tarefa) {
+    uint32_t prazo = agora + cadencia_ms[modo];
+    if ((int32_t)(proxima_tarefa - prazo) < 0) {
+        prazo = proxima_tarefa;
+    }
+    int32_t restante = (int32_t)(prazo - to_ms_since_boot(get_absolute_time()));
+    if (restante > 0) {
+        absolute_time_t limite = make_timeout_time_ms((uint32_t)restante);
+        // qualquer IRQ acorda o WFE; só eventos e o prazo encerram a espera
+        while (!evento_pendente && !time_reached(limite)) {
+            best_effort_wfe_or_timeout(limite);
+        }
+    }
+    evento_pendente = false;
+    despertares[modo]++;
+}
+
+static void relatar_latencia(const char *nome, origem_evento_t origem) {
+    printf("Energia: latencia %s", nome);
+    for (int m = MODO_ATIVO; m <= MODO_ECONOMIA; m++) {
+        const latencia_t *latencia = &latencias[m][origem];
+        printf("%s %s ", m == MODO_ATIVO ? "" : ",", nomes_modo[m]);
+        if (latencia->amostras == 0) {
+            printf("sem eventos");
+            continue;
+        }
+        printf("media %lu us (max %lu, %lu eventos)",
+               (unsigned long)(latencia->soma_us / latencia->amostras),
+               (unsigned long)latencia->maior_us, (unsigned long)latencia->amostras);
+    }
+    printf("\n");
+}
+
+void energia_relatorio(void) {
+    printf("Energia: modo %s, despertares/s ativo %.1f, economia %.1f\n", nomes_modo[modo],
+           tempo_ms[MODO_ATIVO] ? despertares[MODO_ATIVO] * 1000.0f / tempo_ms[MODO_ATIVO] : 0.0f,
+           tempo_ms[MODO_ECONOMIA] ? despertares[MODO_ECONOMIA] * 1000.0f / tempo_ms[MODO_ECONOMIA] : 0.0f);
+    relatar_latencia("botao", ORIGEM_BOTAO);
+    relatar_latencia("HTTP", ORIGEM_HTTP);
+}
@@ -0,0 +1,42 @@
+#ifndef ENERGIA_H
+#define ENERGIA_H
+
+#include "pico/stdlib.h"
+
+// Modo de baixo consumo do painel. Sem requisições HTTP recentes, o rádio
+// CYW43 fica em power save agressivo e o loop principal dorme (WFE) até a
+// próxima tarefa agendada ou até uma IRQ de botão ou de comando da rede. Com
+// clientes, o rádio volta ao modo de desempenho e o loop passa a cada 10 ms.
+// Mede os despertares do loop por segundo e a latência entre o evento (IRQ)
+// e a resposta do loop em cada modo.
+//
+// energia_evento, energia_acordar e energia_atividade_rede podem ser chamadas
+// em contexto de IRQ; as demais, só pelo loop principal.
+
+#define ENERGIA_PASSADA_ATIVO_MS 10      // cadência do loop com clientes
+#define ENERGIA_PASSADA_ECONOMIA_MS 1000 // espera máxima sem clientes
+#define ENERGIA_CLIENTE_INATIVO_MS 30000 // sem requisições por esse tempo: economia
+
+typedef enum {
+    MODO_ATIVO,
+    MODO_ECONOMIA
+} modo_energia_t;
+
+typedef enum {
+    ORIGEM_BOTAO,
+    ORIGEM_HTTP
+} origem_evento_t;
+
+void energia_evento(origem_evento_t origem); // marca o instante do evento e acorda o loop
+void energia_acordar(void);                  // acorda o loop sem medir latência
+void energia_atividade_rede(void);           // requisição HTTP: mantém o modo ativo
+
+// escolhe o modo e ajusta o power save do rádio (só com o link de pé)
+modo_energia_t energia_atualizar(uint32_t agora, bool wifi_conectado);
+// fim da passada que tratou o evento; sem resposta, a medição é descartada
+void energia_concluir(origem_evento_t origem, bool respondido);
+// dorme até a cadência do modo, proxima_tarefa (ms desde o boot) ou um evento
+void energia_aguardar(uint32_t agora, uint32_t proxima_tarefa);
+void energia_relatorio(void);
+
+#endif
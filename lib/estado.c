@@ -0,0 +1,108 @@
+#include <stdio.h>
+#include "estado.h"
+
+#define ESTADO_NUM_CAMPOS 4
+
+static estado_t estado;
+static uint32_t versao;
+static uint32_t versao_campo[ESTADO_NUM_CAMPOS];
+static assinante_t *assinantes[ESTADO_MAX_ASSINANTES];
+static size_t num_assinantes;
+
+static void marcar(int campo) {
+    versao_campo[campo] = ++versao;
+}
+
+// campos alterados depois da versão informada
+static uint32_t campos_desde(uint32_t versao_vista) {
+    uint32_t campos = 0;
+    for (int i = 0; i < ESTADO_NUM_CAMPOS; i++) {
+        if (versao_campo[i] > versao_vista) {
+            campos |= 1u << i;
+        }
+    }
+    return campos;
+}
+
+void estado_init(const estado_t *inicial) {
+    estado = *inicial;
+    versao = 1; // assinantes começam na versão 0 e fazem o primeiro render
+    for (int i = 0; i < ESTADO_NUM_CAMPOS; i++) {
+        versao_campo[i] = versao;
+    }
+}
+
+const estado_t *estado_atual(void) {
+    return &estado;
+}
+
+uint32_t estado_versao(void) {
+    return versao;
+}
+
+void estado_definir_ligado(bool ligado) {
+    if (estado.led_ligado != ligado) {
+        estado.led_ligado = ligado;
+        marcar(0);
+    }
+}
+
+void estado_definir_cor(Cor cor) {
+    if (estado.cor != cor) {
+        estado.cor = cor;
+        marcar(1);
+    }
+}
+
+void estado_definir_emergencia(bool emergencia) {
+    if (estado.emergencia != emergencia) {
+        estado.emergencia = emergencia;
+        marcar(2);
+    }
+}
+
+void estado_definir_temperatura(float temperatura) {
+    if (estado.temperatura != temperatura) { // o ADC é discreto, leituras iguais comparam iguais
+        estado.temperatura = temperatura;
+        marcar(3);
+    }
+}
+
+bool estado_assinar(assinante_t *assinante) {
+    if (num_assinantes >= ESTADO_MAX_ASSINANTES) {
+        return false;
+    }
+    assinante->versao_vista = 0;
+    assinante->renders = 0;
+    assinante->evitados = 0;
+    assinantes[num_assinantes++] = assinante;
+    return true;
+}
+
+void estado_despachar(void) {
+    for (size_t i = 0; i < num_assinantes; i++) {
+        assinante_t *assinante = assinantes[i];
+        if (assinante->versao_vista == versao) { // nada mudou desde o último render
+            assinante->evitados++;
+            continue;
+        }
+        uint32_t campos = campos_desde(assinante->versao_vista) & assinante->mascara;
+        assinante->versao_vista = versao;
+        if (campos) {
+            assinante->render(&estado, campos);
+            assinante->renders++;
+        } else {
+            assinante->evitados++;
+        }
+    }
+}
+
+void estado_relatorio(void) {
+    printf("Estado v%lu:", (unsigned long)versao);
+    for (size_t i = 0; i < num_assinantes; i++) {
+        const assinante_t *assinante = assinantes[i];
+        uint32_t total = assinante->renders + assinante->evitados;
+        printf(" %s %lu/%lu", assinante->nome, (unsigned long)assinante->renders, (unsigned long)total);
+    }
+    printf(" (renders/despachos)\n");
+}
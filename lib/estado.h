@@ -0,0 +1,54 @@
+#ifndef ESTADO_H
+#define ESTADO_H
+
+#include "pico/stdlib.h"
+
+// Armazenamento central do estado do painel. Cada alteração efetiva incrementa
+// um contador de versão e registra a versão do campo alterado; as saídas
+// assinam os campos de que dependem e só são redesenhadas quando algum deles
+// muda. Deve ser usado apenas pelo loop principal.
+
+typedef enum { VERMELHO, VERDE, AZUL, AMARELO, CIANO, LILAS } Cor; // cores do LED RGB
+
+typedef enum {
+    CAMPO_LIGADO = 1u << 0,
+    CAMPO_COR = 1u << 1,
+    CAMPO_EMERGENCIA = 1u << 2,
+    CAMPO_TEMPERATURA = 1u << 3,
+    CAMPO_TODOS = 0x0F
+} campo_estado_t;
+
+typedef struct {
+    bool led_ligado;
+    Cor cor;
+    bool emergencia;
+    float temperatura;
+} estado_t;
+
+typedef void (*estado_render_fn)(const estado_t *estado, uint32_t campos);
+
+typedef struct {
+    const char *nome;         // usado no relatório
+    uint32_t mascara;         // campos observados
+    estado_render_fn render;  // chamado com os campos alterados desde a última vez
+    uint32_t versao_vista;
+    uint32_t renders;         // vezes em que a saída foi redesenhada
+    uint32_t evitados;        // despachos em que nada observado havia mudado
+} assinante_t;
+
+#define ESTADO_MAX_ASSINANTES 8
+
+void estado_init(const estado_t *inicial);
+const estado_t *estado_atual(void);
+uint32_t estado_versao(void);
+
+void estado_definir_ligado(bool ligado);
+void estado_definir_cor(Cor cor);
+void estado_definir_emergencia(bool emergencia);
+void estado_definir_temperatura(float temperatura);
+
+bool estado_assinar(assinante_t *assinante);
+void estado_despachar(void);
+void estado_relatorio(void);
+
+#endif
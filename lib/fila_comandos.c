@@ -0,0 +1,26 @@
+#include "fila_comandos.h"
+#include "hardware/sync.h"
+
+bool fila_comandos_enviar(fila_comandos_t *fila, comando_t comando) {
+    uint32_t cabeca = fila->cabeca;
+    if (cabeca - fila->cauda >= FILA_COMANDOS_TAMANHO) {
+        fila->descartados++;
+        return false;
+    }
+    fila->itens[cabeca & (FILA_COMANDOS_TAMANHO - 1)] = comando;
+    __dmb(); // o item precisa estar visível antes da nova cabeça
+    fila->cabeca = cabeca + 1;
+    return true;
+}
+
+bool fila_comandos_receber(fila_comandos_t *fila, comando_t *comando) {
+    uint32_t cauda = fila->cauda;
+    if (cauda == fila->cabeca) {
+        return false;
+    }
+    __dmb(); // lê o item só depois de observar a cabeça
+    *comando = fila->itens[cauda & (FILA_COMANDOS_TAMANHO - 1)];
+    __dmb(); // libera a posição só depois de copiar o item
+    fila->cauda = cauda + 1;
+    return true;
+}
@@ -0,0 +1,34 @@
+#ifndef FILA_COMANDOS_H
+#define FILA_COMANDOS_H
+
+#include "pico/stdlib.h"
+
+// Fila sem trava de um produtor e um consumidor. O produtor são os callbacks
+// de rede (contexto de IRQ do cyw43_arch threadsafe_background) e o consumidor
+// é o loop principal, que é o único a alterar o estado do painel.
+
+#define FILA_COMANDOS_TAMANHO 16 // potência de 2
+
+typedef enum {
+    CMD_LED_LIGAR,
+    CMD_LED_DESLIGAR,
+    CMD_COR,             // valor = Cor
+    CMD_ALARME_DESLIGAR
+} tipo_comando_t;
+
+typedef struct {
+    uint8_t tipo;
+    uint8_t valor;
+} comando_t;
+
+typedef struct {
+    comando_t itens[FILA_COMANDOS_TAMANHO];
+    volatile uint32_t cabeca;      // escrito só pelo produtor
+    volatile uint32_t cauda;       // escrito só pelo consumidor
+    volatile uint32_t descartados; // comandos perdidos com a fila cheia
+} fila_comandos_t;
+
+bool fila_comandos_enviar(fila_comandos_t *fila, comando_t comando);
+bool fila_comandos_receber(fila_comandos_t *fila, comando_t *comando);
+
+#endif
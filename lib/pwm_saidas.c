@@ -0,0 +1,207 @@
+#include "pwm_saidas.h"
+#include "hardware/pwm.h"
+#include "hardware/clocks.h"
+#include "hardware/sync.h"
+
+#define PWM_CONTADOR_HZ 1000000u // contador dos slices a 1 MHz
+#define PWM_TOPO_PADRAO 999u     // 1 kHz enquanto o buzzer está parado
+#define BUZZER_FREQ_MIN 16u      // abaixo disso o topo não cabe em 16 bits
+#define FADE_PASSO_MS 10u        // intervalo entre passos de um fade
+
+typedef struct {
+    uint slice;
+    uint canal;
+} saida_pwm_t;
+
+static saida_pwm_t led[3];
+static saida_pwm_t buzzer;
+static uint16_t topo[NUM_PWM_SLICES];
+
+// níveis do LED em ponto fixo 8.8 para que o fade tenha passos fracionários
+static int32_t nivel_atual[3];
+static int32_t nivel_alvo[3];
+static int32_t incremento[3];
+static uint8_t alvo_rgb[3];
+static uint32_t passos_restantes;
+static alarm_id_t alarme_fade;
+
+static const passo_buzzer_t *volatile padrao;
+static size_t num_passos;
+static size_t passo_atual;
+static bool repetir_padrao;
+static volatile uint16_t freq_atual;
+static alarm_id_t alarme_buzzer;
+
+static void configurar_pino(uint pino, saida_pwm_t *saida) {
+    gpio_set_function(pino, GPIO_FUNC_PWM);
+    saida->slice = pwm_gpio_to_slice_num(pino);
+    saida->canal = pwm_gpio_to_channel(pino);
+    if (topo[saida->slice] == 0) {
+        pwm_set_clkdiv(saida->slice, (float)clock_get_hz(clk_sys) / PWM_CONTADOR_HZ);
+        pwm_set_wrap(saida->slice, PWM_TOPO_PADRAO);
+        topo[saida->slice] = PWM_TOPO_PADRAO;
+    }
+    pwm_set_chan_level(saida->slice, saida->canal, 0);
+    pwm_set_enabled(saida->slice, true);
+}
+
+// escreve o nível de um canal do LED proporcional ao topo atual do slice
+static void aplicar_led(int i) {
+    uint32_t valor = (uint32_t)(nivel_atual[i] >> 8);
+    uint32_t nivel = valor * ((uint32_t)topo[led[i].slice] + 1) / 255;
+    pwm_set_chan_level(led[i].slice, led[i].canal, (uint16_t)nivel);
+}
+
+static void aplicar_buzzer(uint16_t freq_hz) {
+    freq_atual = freq_hz;
+    if (freq_hz == 0) {
+        pwm_set_chan_level(buzzer.slice, buzzer.canal, 0);
+        return;
+    }
+    if (freq_hz < BUZZER_FREQ_MIN) {
+        freq_hz = BUZZER_FREQ_MIN;
+    }
+    uint16_t novo_topo = (uint16_t)(PWM_CONTADOR_HZ / freq_hz - 1);
+    topo[buzzer.slice] = novo_topo;
+    pwm_set_wrap(buzzer.slice, novo_topo);
+    pwm_set_chan_level(buzzer.slice, buzzer.canal, (uint16_t)((novo_topo + 1) / 2));
+    for (int i = 0; i < 3; i++) { // mantém o duty do LED que divide o slice
+        if (led[i].slice == buzzer.slice) {
+            aplicar_led(i);
+        }
+    }
+}
+
+static int64_t passo_fade(alarm_id_t id, void *dados) {
+    if (--passos_restantes == 0) {
+        for (int i = 0; i < 3; i++) {
+            nivel_atual[i] = nivel_alvo[i];
+            aplicar_led(i);
+        }
+        alarme_fade = 0;
+        return 0;
+    }
+    for (int i = 0; i < 3; i++) {
+        nivel_atual[i] += incremento[i];
+        aplicar_led(i);
+    }
+    return -(int64_t)FADE_PASSO_MS * 1000; // negativo: reagenda a partir do instante previsto, sem deriva
+}
+
+// avança até o próximo passo com duração; false no fim de um padrão sem repetição
+static bool avancar_passo(void) {
+    do {
+        if (++passo_atual >= num_passos) {
+            if (!repetir_padrao) {
+                return false;
+            }
+            passo_atual = 0;
+        }
+    } while (padrao[passo_atual].duracao_ms == 0); // termina: buzzer_padrao exige um passo com duração
+    return true;
+}
+
+static int64_t passo_buzzer(alarm_id_t id, void *dados) {
+    if (!avancar_passo()) {
+        aplicar_buzzer(0);
+        padrao = NULL;
+        alarme_buzzer = 0;
+        return 0;
+    }
+    aplicar_buzzer(padrao[passo_atual].freq_hz);
+    return -(int64_t)padrao[passo_atual].duracao_ms * 1000; // a partir do fim do passo anterior
+}
+
+static void cancelar(alarm_id_t *alarme) {
+    if (*alarme > 0) {
+        cancel_alarm(*alarme);
+    }
+    *alarme = 0;
+}
+
+void pwm_saidas_init(uint pino_r, uint pino_g, uint pino_b, uint pino_buzzer) {
+    configurar_pino(pino_r, &led[0]);
+    configurar_pino(pino_g, &led[1]);
+    configurar_pino(pino_b, &led[2]);
+    configurar_pino(pino_buzzer, &buzzer);
+}
+
+void rgb_pwm_definir(uint8_t r, uint8_t g, uint8_t b) {
+    cancelar(&alarme_fade);
+    uint8_t cor[3] = {r, g, b};
+    uint32_t estado_irq = save_and_disable_interrupts();
+    for (int i = 0; i < 3; i++) {
+        alvo_rgb[i] = cor[i];
+        nivel_atual[i] = nivel_alvo[i] = (int32_t)cor[i] << 8;
+        aplicar_led(i);
+    }
+    restore_interrupts(estado_irq);
+}
+
+void rgb_pwm_fade(uint8_t r, uint8_t g, uint8_t b, uint32_t duracao_ms) {
+    if (alvo_rgb[0] == r && alvo_rgb[1] == g && alvo_rgb[2] == b) {
+        return; // já está na cor ou a caminho dela
+    }
+    if (duracao_ms < FADE_PASSO_MS) {
+        rgb_pwm_definir(r, g, b);
+        return;
+    }
+    cancelar(&alarme_fade);
+    uint8_t cor[3] = {r, g, b};
+    uint32_t passos = duracao_ms / FADE_PASSO_MS;
+    for (int i = 0; i < 3; i++) {
+        alvo_rgb[i] = cor[i];
+        nivel_alvo[i] = (int32_t)cor[i] << 8;
+        incremento[i] = (nivel_alvo[i] - nivel_atual[i]) / (int32_t)passos;
+    }
+    passos_restantes = passos;
+    alarme_fade = add_alarm_in_ms(FADE_PASSO_MS, passo_fade, NULL, true);
+    if (alarme_fade < 0) { // sem alarme livre: vai direto à cor final
+        alarme_fade = 0;
+        rgb_pwm_definir(r, g, b);
+    }
+}
+
+void buzzer_tom(uint16_t freq_hz) {
+    cancelar(&alarme_buzzer);
+    uint32_t estado_irq = save_and_disable_interrupts();
+    padrao = NULL;
+    aplicar_buzzer(freq_hz);
+    restore_interrupts(estado_irq);
+}
+
+void buzzer_padrao(const passo_buzzer_t *passos, size_t quantidade, bool repetir) {
+    cancelar(&alarme_buzzer);
+    size_t primeiro = 0;
+    while (primeiro < quantidade && passos[primeiro].duracao_ms == 0) { // passos sem duração são pulados
+        primeiro++;
+    }
+    if (primeiro == quantidade) { // nenhum passo com duração: nada a tocar
+        buzzer_tom(0);
+        return;
+    }
+    uint32_t estado_irq = save_and_disable_interrupts();
+    padrao = passos;
+    num_passos = quantidade;
+    passo_atual = primeiro;
+    repetir_padrao = repetir;
+    aplicar_buzzer(passos[primeiro].freq_hz);
+    restore_interrupts(estado_irq);
+    alarme_buzzer = add_alarm_in_ms(passos[primeiro].duracao_ms, passo_buzzer, NULL, true);
+    if (alarme_buzzer < 0) { // sem alarme livre: estado final na hora
+        alarme_buzzer = 0;
+        uint16_t freq_final = 0; // padrão sem repetição termina em silêncio
+        for (size_t i = 0; repetir && i < quantidade && freq_final == 0; i++) {
+            freq_final = passos[i].freq_hz; // alarme repetido vira tom contínuo: não pode calar
+        }
+        buzzer_tom(freq_final);
+    }
+}
+
+void buzzer_parar(void) {
+    buzzer_tom(0);
+}
+
+bool buzzer_ativo(void) {
+    return padrao != NULL || freq_atual != 0;
+}
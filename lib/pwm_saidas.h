@@ -0,0 +1,31 @@
+#ifndef PWM_SAIDAS_H
+#define PWM_SAIDAS_H
+
+#include <stddef.h>
+#include "pico/stdlib.h"
+
+// Saídas PWM do painel: LED RGB com cor de 8 bits e transições (fades)
+// temporizadas por alarme de hardware, e buzzer com frequência e padrões
+// de alarme. Depois de configuradas, as saídas não dependem do loop principal.
+//
+// No BitDogLab o buzzer (GPIO 10, canal A) e o LED verde (GPIO 11, canal B)
+// dividem o slice 5; ao mudar a frequência do buzzer o nível do verde é
+// reescalado para manter o mesmo duty cycle.
+
+// passo de um padrão do buzzer (freq_hz = 0 é silêncio; passos com duracao_ms = 0 são pulados)
+typedef struct {
+    uint16_t freq_hz;
+    uint16_t duracao_ms;
+} passo_buzzer_t;
+
+void pwm_saidas_init(uint pino_r, uint pino_g, uint pino_b, uint pino_buzzer);
+
+void rgb_pwm_definir(uint8_t r, uint8_t g, uint8_t b);
+void rgb_pwm_fade(uint8_t r, uint8_t g, uint8_t b, uint32_t duracao_ms);
+
+void buzzer_tom(uint16_t freq_hz);
+void buzzer_padrao(const passo_buzzer_t *passos, size_t quantidade, bool repetir);
+void buzzer_parar(void);
+bool buzzer_ativo(void);
+
+#endif
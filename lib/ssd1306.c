@@ -68,6 +68,31 @@ void ssd1306_send_data(ssd1306_t *ssd) {
   );
 }
 
+// Envia apenas as colunas x0..x1 das páginas page0..page1. No modo de
+// endereçamento vertical o controlador recebe as páginas de cada coluna em
+// sequência, a mesma ordem do ram_buffer, que é copiado para um buffer de envio.
+void ssd1306_send_region(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t page0, uint8_t page1) {
+  static uint8_t buffer[1 + WIDTH * HEIGHT / 8];
+  size_t n = 0;
+  buffer[n++] = 0x40;
+  for (uint8_t x = x0; x <= x1; ++x)
+    for (uint8_t page = page0; page <= page1; ++page)
+      buffer[n++] = ssd->ram_buffer[(x << 3) + page + 1];
+  ssd1306_command(ssd, SET_COL_ADDR);
+  ssd1306_command(ssd, x0);
+  ssd1306_command(ssd, x1);
+  ssd1306_command(ssd, SET_PAGE_ADDR);
+  ssd1306_command(ssd, page0);
+  ssd1306_command(ssd, page1);
+  i2c_write_blocking(
+    ssd->i2c_port,
+    ssd->address,
+    buffer,
+    n,
+    false
+  );
+}
+
 void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value) {
   uint16_t index = (y >> 3) + (x << 3) + 1;
   uint8_t pixel = (y & 0b111);
@@ -0,0 +1,145 @@
+#include <stdio.h>
+#include "supervisor_wifi.h"
+#include "pico/cyw43_arch.h"
+
+#define SUPERVISOR_PERIODO_MS 100    // intervalo entre consultas ao status do link
+#define TENTATIVA_TIMEOUT_MS 20000   // tentativa sem link após esse tempo conta como falha
+#define BACKOFF_MIN_MS 1000
+#define BACKOFF_MAX_MS 60000
+
+static const char *ssid;
+static const char *senha;
+static uint32_t autenticacao;
+static wifi_evento_fn evento;
+
+static estado_wifi_t estado = WIFI_INICIANDO;
+static int status_link = CYW43_LINK_DOWN;
+static uint32_t ultima_consulta;
+static uint32_t inicio_tentativa;
+static uint32_t proxima_tentativa;
+static uint32_t backoff_ms = BACKOFF_MIN_MS;
+static uint32_t inicio_queda;
+static bool em_queda;
+static diagnostico_wifi_t diagnostico;
+
+static void mudar(estado_wifi_t novo) {
+    estado = novo;
+    if (evento) {
+        evento(estado, status_link);
+    }
+}
+
+// espera o backoff atual antes da próxima tentativa e dobra o próximo
+static void agendar_tentativa(uint32_t agora) {
+    diagnostico.falhas++;
+    proxima_tentativa = agora + backoff_ms;
+    printf("Wi-Fi: nova tentativa em %lu ms\n", (unsigned long)backoff_ms);
+    backoff_ms = backoff_ms * 2 > BACKOFF_MAX_MS ? BACKOFF_MAX_MS : backoff_ms * 2;
+    mudar(WIFI_AGUARDANDO);
+}
+
+static void iniciar_tentativa(uint32_t agora) {
+    if (diagnostico.tentativas > 0) {
+        cyw43_wifi_leave(&cyw43_state, CYW43_ITF_STA); // descarta associação anterior pela metade
+    }
+    diagnostico.tentativas++;
+    inicio_tentativa = agora;
+    status_link = CYW43_LINK_DOWN;
+    if (cyw43_arch_wifi_connect_async(ssid, senha, autenticacao)) {
+        agendar_tentativa(agora);
+        return;
+    }
+    mudar(WIFI_CONECTANDO);
+}
+
+static void conectado(uint32_t agora) {
+    backoff_ms = BACKOFF_MIN_MS;
+    if (em_queda) {
+        uint32_t duracao = agora - inicio_queda;
+        diagnostico.ultima_reconexao_ms = duracao;
+        diagnostico.total_fora_ms += duracao;
+        if (duracao > diagnostico.maior_reconexao_ms) {
+            diagnostico.maior_reconexao_ms = duracao;
+        }
+        em_queda = false;
+        printf("Wi-Fi: reconectado em %lu ms\n", (unsigned long)duracao);
+    }
+    mudar(WIFI_CONECTADO);
+}
+
+void supervisor_wifi_init(const char *ssid_rede, const char *senha_rede, uint32_t auth, wifi_evento_fn callback) {
+    ssid = ssid_rede;
+    senha = senha_rede;
+    autenticacao = auth;
+    evento = callback;
+}
+
+void supervisor_wifi_atualizar(uint32_t agora) {
+    if (estado == WIFI_INICIANDO) {
+        if (cyw43_arch_init()) { // carrega o firmware do rádio (bloqueia ~centenas de ms uma única vez)
+            printf("Falha na inicialização do Wi-Fi\n");
+            mudar(WIFI_AUSENTE);
+            return;
+        }
+        cyw43_arch_enable_sta_mode();
+        iniciar_tentativa(agora);
+        return;
+    }
+    if (estado == WIFI_AUSENTE || agora - ultima_consulta < SUPERVISOR_PERIODO_MS) {
+        return;
+    }
+    ultima_consulta = agora;
+
+    if (estado == WIFI_AGUARDANDO) {
+        if ((int32_t)(agora - proxima_tentativa) >= 0) {
+            iniciar_tentativa(agora);
+        }
+        return;
+    }
+
+    int status = cyw43_tcpip_link_status(&cyw43_state, CYW43_ITF_STA);
+    if (estado == WIFI_CONECTADO) {
+        if (status != CYW43_LINK_UP) { // ponto de acesso caiu ou o IP foi perdido
+            diagnostico.quedas++;
+            inicio_queda = agora;
+            em_queda = true;
+            printf("Wi-Fi: link perdido (status %d), reconectando\n", status);
+            iniciar_tentativa(agora);
+        }
+        return;
+    }
+
+    // WIFI_CONECTANDO
+    if (status != status_link) {
+        status_link = status;
+        if (status == CYW43_LINK_UP) {
+            conectado(agora);
+            return;
+        }
+        if (evento) {
+            evento(estado, status_link);
+        }
+    }
+    if (status == CYW43_LINK_FAIL || status == CYW43_LINK_NONET || status == CYW43_LINK_BADAUTH) {
+        printf("Falha na conexão Wi-Fi (status %d)\n", status);
+        agendar_tentativa(agora);
+    } else if (agora - inicio_tentativa >= TENTATIVA_TIMEOUT_MS) {
+        printf("Wi-Fi: tentativa expirou\n");
+        agendar_tentativa(agora);
+    }
+}
+
+estado_wifi_t supervisor_wifi_estado(void) {
+    return estado;
+}
+
+const diagnostico_wifi_t *supervisor_wifi_diagnostico(void) {
+    return &diagnostico;
+}
+
+void supervisor_wifi_relatorio(void) {
+    printf("Wi-Fi: quedas %lu, tentativas %lu, falhas %lu, ultima reconexao %lu ms, maior %lu ms, fora %lu ms\n",
+           (unsigned long)diagnostico.quedas, (unsigned long)diagnostico.tentativas,
+           (unsigned long)diagnostico.falhas, (unsigned long)diagnostico.ultima_reconexao_ms,
+           (unsigned long)diagnostico.maior_reconexao_ms, (unsigned long)diagnostico.total_fora_ms);
+}
@@ -0,0 +1,36 @@
+#ifndef SUPERVISOR_WIFI_H
+#define SUPERVISOR_WIFI_H
+
+#include "pico/stdlib.h"
+
+// Supervisor do link Wi-Fi. Acompanha cyw43_tcpip_link_status a cada
+// chamada de supervisor_wifi_atualizar e reconecta de forma assíncrona com
+// espera exponencial entre tentativas, sem nunca bloquear o loop principal.
+
+typedef enum {
+    WIFI_INICIANDO,  // cyw43 ainda não inicializado
+    WIFI_CONECTANDO, // associação e DHCP em andamento
+    WIFI_CONECTADO,  // link com IP
+    WIFI_AGUARDANDO, // esperando o fim do backoff para tentar de novo
+    WIFI_AUSENTE     // cyw43_arch_init falhou, não há rádio
+} estado_wifi_t;
+
+typedef struct {
+    uint32_t quedas;              // perdas de link depois de conectado
+    uint32_t tentativas;          // conexões iniciadas
+    uint32_t falhas;              // tentativas que falharam ou expiraram
+    uint32_t ultima_reconexao_ms; // da queda até o link voltar, na última queda
+    uint32_t maior_reconexao_ms;
+    uint32_t total_fora_ms;       // soma do tempo sem link após quedas
+} diagnostico_wifi_t;
+
+// chamado a cada mudança de estado ou de status do link (CYW43_LINK_*)
+typedef void (*wifi_evento_fn)(estado_wifi_t estado, int status_link);
+
+void supervisor_wifi_init(const char *ssid, const char *senha, uint32_t autenticacao, wifi_evento_fn evento);
+void supervisor_wifi_atualizar(uint32_t agora_ms);
+estado_wifi_t supervisor_wifi_estado(void);
+const diagnostico_wifi_t *supervisor_wifi_diagnostico(void);
+void supervisor_wifi_relatorio(void);
+
+#endif
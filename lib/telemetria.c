@@ -0,0 +1,161 @@
+#include <stdio.h>
+#include "telemetria.h"
+#include "pico/cyw43_arch.h"
+#include "lwip/udp.h"
+
+#define CABECALHO_BYTES 12
+#define REGISTRO_BYTES 8
+#define REGISTROS_LOOP 3 // reservados para as métricas do loop ao fechar o lote
+
+static uint8_t datagrama[CABECALHO_BYTES + TELEMETRIA_MAX_REGISTROS * REGISTRO_BYTES];
+static uint8_t quantidade;
+static uint32_t inicio_lote;
+static uint32_t sequencia;
+static uint32_t ultimo_lote;
+
+static bool ativo;
+static ip_addr_t coletor;
+static uint16_t porta_coletor;
+static uint32_t intervalo_ms;
+static bool rede_pronta_atual;
+static struct udp_pcb *pcb;
+
+// métricas do loop desde o último lote
+static uint32_t passadas;
+static uint32_t maior_passada_us;
+static uint64_t soma_passadas_us;
+
+static uint32_t lotes_enviados;
+static uint32_t lotes_perdidos; // fechados sem rede ou sem memória no lwIP
+static uint32_t bytes_enviados;
+
+static void escrever_u16(uint8_t *destino, uint16_t valor) {
+    destino[0] = (uint8_t)valor;
+    destino[1] = (uint8_t)(valor >> 8);
+}
+
+static void escrever_u32(uint8_t *destino, uint32_t valor) {
+    escrever_u16(destino, (uint16_t)valor);
+    escrever_u16(destino + 2, (uint16_t)(valor >> 16));
+}
+
+static bool enviar(uint16_t tamanho) {
+    bool enviado = false;
+    cyw43_arch_lwip_begin();
+    if (!pcb) {
+        pcb = udp_new(); // criado só com a rede de pé (o lwIP nasce no cyw43_arch_init)
+    }
+    if (pcb) {
+        struct pbuf *p = pbuf_alloc(PBUF_TRANSPORT, tamanho, PBUF_RAM);
+        if (p) {
+            pbuf_take(p, datagrama, tamanho);
+            enviado = udp_sendto(pcb, p, &coletor, porta_coletor) == ERR_OK;
+            pbuf_free(p);
+        }
+    }
+    cyw43_arch_lwip_end();
+    return enviado;
+}
+
+static void adicionar(uint32_t agora, uint8_t tipo, uint8_t campo, int32_t valor) {
+    if (quantidade == 0) {
+        inicio_lote = agora;
+    }
+    uint32_t atraso = agora - inicio_lote;
+    uint8_t *registro = datagrama + CABECALHO_BYTES + quantidade * REGISTRO_BYTES;
+    registro[0] = tipo;
+    registro[1] = campo;
+    escrever_u16(registro + 2, (uint16_t)(atraso > UINT16_MAX ? UINT16_MAX : atraso));
+    escrever_u32(registro + 4, (uint32_t)valor);
+    quantidade++;
+}
+
+// completa o lote com as métricas do loop, numera e envia
+static void fechar_lote(uint32_t agora) {
+    if (passadas > 0) {
+        adicionar(agora, TELEMETRIA_LOOP, TELEMETRIA_LOOP_PASSADAS, (int32_t)passadas);
+        adicionar(agora, TELEMETRIA_LOOP, TELEMETRIA_LOOP_MAIOR_US, (int32_t)maior_passada_us);
+        adicionar(agora, TELEMETRIA_LOOP, TELEMETRIA_LOOP_MEDIA_US, (int32_t)(soma_passadas_us / passadas));
+        passadas = 0;
+        maior_passada_us = 0;
+        soma_passadas_us = 0;
+    }
+    ultimo_lote = agora;
+    if (quantidade == 0) {
+        return;
+    }
+    datagrama[0] = 'P';
+    datagrama[1] = 'T';
+    datagrama[2] = TELEMETRIA_VERSAO;
+    datagrama[3] = quantidade;
+    escrever_u32(datagrama + 4, sequencia++); // lote perdido aqui também consome um número
+    escrever_u32(datagrama + 8, inicio_lote);
+    uint16_t tamanho = (uint16_t)(CABECALHO_BYTES + quantidade * REGISTRO_BYTES);
+    if (rede_pronta_atual && enviar(tamanho)) {
+        lotes_enviados++;
+        bytes_enviados += tamanho;
+    } else {
+        lotes_perdidos++;
+    }
+    quantidade = 0;
+}
+
+static void registrar(uint32_t agora, uint8_t tipo, uint8_t campo, int32_t valor) {
+    if (!ativo) {
+        return;
+    }
+    if (quantidade >= TELEMETRIA_MAX_REGISTROS - REGISTROS_LOOP) { // lote cheio antes do intervalo
+        fechar_lote(agora);
+    }
+    adicionar(agora, tipo, campo, valor);
+}
+
+void telemetria_configurar(uint32_t coletor_ip, uint16_t porta, uint32_t intervalo) {
+    ip_addr_set_ip4_u32(&coletor, coletor_ip);
+    porta_coletor = porta;
+    intervalo_ms = intervalo > TELEMETRIA_INTERVALO_MAX_MS ? TELEMETRIA_INTERVALO_MAX_MS : intervalo;
+    ativo = coletor_ip != 0 && porta != 0 && intervalo_ms > 0;
+    quantidade = 0;
+    ultimo_lote = to_ms_since_boot(get_absolute_time());
+}
+
+void telemetria_temperatura(uint32_t agora, float temperatura) {
+    registrar(agora, TELEMETRIA_TEMPERATURA, 0, (int32_t)(temperatura * 100));
+}
+
+void telemetria_estado(uint32_t agora, const estado_t *estado, uint32_t campos) {
+    uint32_t alterados = campos & (CAMPO_LIGADO | CAMPO_COR | CAMPO_EMERGENCIA);
+    if (alterados == 0) {
+        return;
+    }
+    int32_t valor = (estado->led_ligado ? 1 : 0) | ((int32_t)estado->cor << 1) | (estado->emergencia ? 1 << 4 : 0);
+    registrar(agora, TELEMETRIA_ESTADO, (uint8_t)alterados, valor);
+}
+
+void telemetria_passada(uint32_t duracao_us) {
+    if (!ativo) {
+        return;
+    }
+    passadas++;
+    soma_passadas_us += duracao_us;
+    if (duracao_us > maior_passada_us) {
+        maior_passada_us = duracao_us;
+    }
+}
+
+void telemetria_atualizar(uint32_t agora, bool rede_pronta) {
+    rede_pronta_atual = rede_pronta;
+    if (ativo && agora - ultimo_lote >= intervalo_ms) {
+        fechar_lote(agora);
+    }
+}
+
+void telemetria_relatorio(void) {
+    if (!ativo) {
+        printf("Telemetria: desligada\n");
+        return;
+    }
+    printf("Telemetria: %s:%u a cada %lu ms, %lu lotes enviados (%lu bytes), %lu perdidos\n",
+           ipaddr_ntoa(&coletor), porta_coletor, (unsigned long)intervalo_ms,
+           (unsigned long)lotes_enviados, (unsigned long)bytes_enviados, (unsigned long)lotes_perdidos);
+}
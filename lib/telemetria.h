@@ -0,0 +1,48 @@
+#ifndef TELEMETRIA_H
+#define TELEMETRIA_H
+
+#include "pico/stdlib.h"
+#include "estado.h"
+
+// Telemetria por UDP: amostras de temperatura, mudanças de estado e métricas
+// do loop são acumuladas em RAM e enviadas em lote, num datagrama binário, ao
+// coletor configurado a cada intervalo (ou antes, se o lote encher). Cada lote
+// tem um número de sequência, então o coletor percebe datagramas perdidos.
+// Deve ser usado apenas pelo loop principal.
+//
+// Datagrama (little-endian):
+//   cabeçalho, 12 bytes: 'P' 'T', versão (1), quantidade de registros,
+//                        sequência (u32), instante do primeiro registro em ms (u32)
+//   registros, 8 bytes:  tipo (u8), campo (u8), ms desde o início do lote (u16), valor (i32)
+//
+//   TELEMETRIA_TEMPERATURA  valor em centésimos de °C
+//   TELEMETRIA_ESTADO       campo = campos alterados; valor: bit 0 LED, bits 1-3 cor, bit 4 emergência
+//   TELEMETRIA_LOOP         campo TELEMETRIA_LOOP_*: passadas, maior e média da duração (µs)
+
+#define TELEMETRIA_VERSAO 1
+#define TELEMETRIA_MAX_REGISTROS 48
+#define TELEMETRIA_INTERVALO_MAX_MS 60000
+
+typedef enum {
+    TELEMETRIA_TEMPERATURA = 1,
+    TELEMETRIA_ESTADO = 2,
+    TELEMETRIA_LOOP = 3
+} tipo_telemetria_t;
+
+typedef enum {
+    TELEMETRIA_LOOP_PASSADAS,
+    TELEMETRIA_LOOP_MAIOR_US,
+    TELEMETRIA_LOOP_MEDIA_US
+} campo_loop_t;
+
+// coletor_ip na ordem de bytes do lwIP (ip4_addr_get_u32); 0 desliga o envio
+void telemetria_configurar(uint32_t coletor_ip, uint16_t porta, uint32_t intervalo_ms);
+
+void telemetria_temperatura(uint32_t agora, float temperatura);
+void telemetria_estado(uint32_t agora, const estado_t *estado, uint32_t campos);
+void telemetria_passada(uint32_t duracao_us);
+
+void telemetria_atualizar(uint32_t agora, bool rede_pronta);
+void telemetria_relatorio(void);
+
+#endif
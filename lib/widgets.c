@@ -0,0 +1,252 @@
+#include <string.h>
+#include "widgets.h"
+
+static void widget_base(widget_t *w, tipo_widget_t tipo, uint8_t x, uint8_t y, uint8_t largura, uint8_t altura) {
+    memset(w, 0, sizeof(*w));
+    w->tipo = tipo;
+    w->area = (retangulo_t){x, y, largura, altura};
+    w->visivel = true;
+    w->sujo = true;
+}
+
+void widget_rotulo(widget_t *w, uint8_t x, uint8_t y, const char *texto) {
+    size_t caracteres = strlen(texto);
+    if (caracteres > WIDGET_TEXTO_MAX) {
+        caracteres = WIDGET_TEXTO_MAX;
+    }
+    widget_base(w, WIDGET_ROTULO, x, y, (uint8_t)(caracteres * 8), 8);
+    strncpy(w->texto, texto, WIDGET_TEXTO_MAX);
+}
+
+void widget_valor(widget_t *w, uint8_t x, uint8_t y, uint8_t caracteres) {
+    if (caracteres > WIDGET_TEXTO_MAX) {
+        caracteres = WIDGET_TEXTO_MAX;
+    }
+    widget_base(w, WIDGET_VALOR, x, y, caracteres * 8, 8);
+}
+
+void widget_barra(widget_t *w, uint8_t x, uint8_t y, uint8_t largura, uint8_t altura) {
+    widget_base(w, WIDGET_BARRA, x, y, largura, altura);
+}
+
+void widget_icone(widget_t *w, uint8_t x, uint8_t y, const uint8_t *bitmap) {
+    widget_base(w, WIDGET_ICONE, x, y, 8, 8);
+    w->icone.bitmap = bitmap;
+}
+
+void widget_sparkline(widget_t *w, uint8_t x, uint8_t y, uint8_t largura, uint8_t altura,
+                      int16_t *amostras, uint8_t capacidade, int16_t faixa_minima) {
+    widget_base(w, WIDGET_SPARKLINE, x, y, largura, altura);
+    w->sparkline.amostras = amostras;
+    w->sparkline.capacidade = capacidade;
+    w->sparkline.faixa_minima = faixa_minima > 0 ? faixa_minima : 1;
+}
+
+void widget_texto_definir(widget_t *w, const char *texto) {
+    if (strncmp(w->texto, texto, WIDGET_TEXTO_MAX) != 0) {
+        strncpy(w->texto, texto, WIDGET_TEXTO_MAX);
+        w->sujo = true;
+    }
+}
+
+void widget_barra_definir(widget_t *w, uint8_t percentual) {
+    if (percentual > 100) {
+        percentual = 100;
+    }
+    if (w->percentual != percentual) {
+        w->percentual = percentual;
+        w->sujo = true;
+    }
+}
+
+void widget_icone_definir(widget_t *w, bool ligado) {
+    if (w->icone.ligado != ligado) {
+        w->icone.ligado = ligado;
+        w->sujo = true;
+    }
+}
+
+void widget_sparkline_adicionar(widget_t *w, int16_t amostra) {
+    uint8_t capacidade = w->sparkline.capacidade;
+    if (w->sparkline.quantidade < capacidade) {
+        w->sparkline.amostras[(w->sparkline.inicio + w->sparkline.quantidade) % capacidade] = amostra;
+        w->sparkline.quantidade++;
+    } else { // buffer cheio: descarta a amostra mais antiga
+        w->sparkline.amostras[w->sparkline.inicio] = amostra;
+        w->sparkline.inicio = (w->sparkline.inicio + 1) % capacidade;
+    }
+    w->sujo = true;
+}
+
+void widget_visivel(widget_t *w, bool visivel) {
+    if (w->visivel != visivel) {
+        w->visivel = visivel;
+        w->sujo = true;
+    }
+}
+
+static void desenhar_texto(ssd1306_t *ssd, const widget_t *w) {
+    uint8_t caracteres = w->area.largura / 8;
+    for (uint8_t i = 0; i < caracteres && w->texto[i]; i++) {
+        ssd1306_draw_char(ssd, w->texto[i], w->area.x + i * 8, w->area.y);
+    }
+}
+
+static void desenhar_barra(ssd1306_t *ssd, const widget_t *w) {
+    const retangulo_t *a = &w->area;
+    ssd1306_rect(ssd, a->y, a->x, a->largura, a->altura, true, false);
+    uint8_t preenchido = (uint8_t)((a->largura - 4) * w->percentual / 100);
+    if (preenchido > 0) {
+        ssd1306_rect(ssd, a->y + 2, a->x + 2, preenchido, a->altura - 4, true, true);
+    }
+}
+
+static void desenhar_icone(ssd1306_t *ssd, const widget_t *w) {
+    if (!w->icone.ligado) {
+        return;
+    }
+    for (uint8_t i = 0; i < 8; i++) {
+        uint8_t coluna = w->icone.bitmap[i];
+        for (uint8_t j = 0; j < 8; j++) {
+            ssd1306_pixel(ssd, w->area.x + i, w->area.y + j, coluna & (1 << j));
+        }
+    }
+}
+
+static void desenhar_sparkline(ssd1306_t *ssd, const widget_t *w) {
+    uint8_t quantidade = w->sparkline.quantidade;
+    if (quantidade == 0) {
+        return;
+    }
+    int32_t minimo = INT16_MAX, maximo = INT16_MIN;
+    for (uint8_t i = 0; i < quantidade; i++) {
+        int16_t valor = w->sparkline.amostras[(w->sparkline.inicio + i) % w->sparkline.capacidade];
+        minimo = valor < minimo ? valor : minimo;
+        maximo = valor > maximo ? valor : maximo;
+    }
+    int32_t faixa = maximo - minimo;
+    if (faixa < w->sparkline.faixa_minima) { // centraliza séries quase planas
+        minimo -= (w->sparkline.faixa_minima - faixa) / 2;
+        faixa = w->sparkline.faixa_minima;
+    }
+    const retangulo_t *a = &w->area;
+    uint8_t passo_x = w->sparkline.capacidade > 1 ? (a->largura - 1) / (w->sparkline.capacidade - 1) : 0;
+    uint8_t x_anterior = 0, y_anterior = 0;
+    for (uint8_t i = 0; i < quantidade; i++) {
+        int16_t valor = w->sparkline.amostras[(w->sparkline.inicio + i) % w->sparkline.capacidade];
+        uint8_t x = a->x + i * passo_x;
+        uint8_t y = a->y + a->altura - 1 - (uint8_t)((int32_t)(valor - minimo) * (a->altura - 1) / faixa);
+        if (i > 0) {
+            ssd1306_line(ssd, x_anterior, y_anterior, x, y, true);
+        } else {
+            ssd1306_pixel(ssd, x, y, true);
+        }
+        x_anterior = x;
+        y_anterior = y;
+    }
+}
+
+static void desenhar(ssd1306_t *ssd, const widget_t *w) {
+    const retangulo_t *a = &w->area;
+    ssd1306_rect(ssd, a->y, a->x, a->largura, a->altura, false, true); // limpa só a área do widget
+    if (!w->visivel) {
+        return;
+    }
+    switch (w->tipo) {
+        case WIDGET_ROTULO:
+        case WIDGET_VALOR: desenhar_texto(ssd, w); break;
+        case WIDGET_BARRA: desenhar_barra(ssd, w); break;
+        case WIDGET_ICONE: desenhar_icone(ssd, w); break;
+        case WIDGET_SPARKLINE: desenhar_sparkline(ssd, w); break;
+    }
+}
+
+static bool sobrepoe(const retangulo_t *a, const retangulo_t *b) {
+    return a->x <= b->x + b->largura && b->x <= a->x + a->largura &&
+           a->y <= b->y + b->altura && b->y <= a->y + a->altura;
+}
+
+static bool intersecta(const retangulo_t *a, const retangulo_t *b) {
+    return a->x < b->x + b->largura && b->x < a->x + a->largura &&
+           a->y < b->y + b->altura && b->y < a->y + a->altura;
+}
+
+static void unir(retangulo_t *destino, const retangulo_t *r) {
+    uint8_t x1 = MAX(destino->x + destino->largura, r->x + r->largura);
+    uint8_t y1 = MAX(destino->y + destino->altura, r->y + r->altura);
+    destino->x = MIN(destino->x, r->x);
+    destino->y = MIN(destino->y, r->y);
+    destino->largura = x1 - destino->x;
+    destino->altura = y1 - destino->y;
+}
+
+// registra uma área danificada, juntando com as que se tocam
+static void danificar(tela_t *tela, const retangulo_t *r) {
+    for (uint8_t i = 0; i < tela->num_danos; i++) {
+        if (sobrepoe(&tela->danos[i], r)) {
+            unir(&tela->danos[i], r);
+            return;
+        }
+    }
+    if (tela->num_danos < TELA_MAX_DANOS) {
+        tela->danos[tela->num_danos++] = *r;
+    } else { // lista cheia: acumula na última área
+        unir(&tela->danos[TELA_MAX_DANOS - 1], r);
+    }
+}
+
+void tela_init(tela_t *tela, ssd1306_t *ssd) {
+    memset(tela, 0, sizeof(*tela));
+    tela->ssd = ssd;
+}
+
+bool tela_adicionar(tela_t *tela, widget_t *w) {
+    if (tela->num_widgets >= TELA_MAX_WIDGETS) {
+        return false;
+    }
+    tela->widgets[tela->num_widgets++] = w;
+    w->sujo = true;
+    return true;
+}
+
+// redesenha no buffer os widgets alterados e retorna quantas áreas estão danificadas
+uint8_t tela_renderizar(tela_t *tela) {
+    // widgets ocultados primeiro: limpar a área pode apagar um widget visível
+    // que a divide, e esse vizinho é redesenhado na segunda passada
+    for (uint8_t i = 0; i < tela->num_widgets; i++) {
+        widget_t *w = tela->widgets[i];
+        if (w->sujo && !w->visivel) {
+            desenhar(tela->ssd, w);
+            danificar(tela, &w->area);
+            w->sujo = false;
+            for (uint8_t j = 0; j < tela->num_widgets; j++) {
+                widget_t *vizinho = tela->widgets[j];
+                if (vizinho->visivel && intersecta(&vizinho->area, &w->area)) {
+                    vizinho->sujo = true;
+                }
+            }
+        }
+    }
+    for (uint8_t i = 0; i < tela->num_widgets; i++) {
+        widget_t *w = tela->widgets[i];
+        if (w->sujo) {
+            desenhar(tela->ssd, w);
+            danificar(tela, &w->area);
+            w->sujo = false;
+        }
+    }
+    return tela->num_danos;
+}
+
+// envia ao display só as áreas danificadas, alinhadas às páginas de 8 linhas
+void tela_enviar(tela_t *tela) {
+    for (uint8_t i = 0; i < tela->num_danos; i++) {
+        const retangulo_t *r = &tela->danos[i];
+        uint8_t x1 = r->x + r->largura - 1;
+        uint8_t pagina0 = r->y / 8;
+        uint8_t pagina1 = (r->y + r->altura - 1) / 8;
+        ssd1306_send_region(tela->ssd, r->x, x1, pagina0, pagina1);
+        tela->bytes_enviados += (uint32_t)r->largura * (pagina1 - pagina0 + 1);
+    }
+    tela->num_danos = 0;
+}
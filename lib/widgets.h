@@ -0,0 +1,75 @@
+#ifndef WIDGETS_H
+#define WIDGETS_H
+
+#include "ssd1306.h"
+
+// Camada de widgets retidos sobre o ssd1306_t. Cada widget tem uma área fixa
+// e só é redesenhado quando o valor associado muda; a tela acumula as áreas
+// danificadas e envia ao display apenas essas regiões.
+
+#define WIDGET_TEXTO_MAX 16 // 16 caracteres de 8px ocupam a largura toda
+#define TELA_MAX_WIDGETS 12
+#define TELA_MAX_DANOS 6
+
+typedef enum {
+    WIDGET_ROTULO,
+    WIDGET_VALOR,
+    WIDGET_BARRA,
+    WIDGET_ICONE,
+    WIDGET_SPARKLINE
+} tipo_widget_t;
+
+typedef struct {
+    uint8_t x, y, largura, altura;
+} retangulo_t;
+
+typedef struct {
+    tipo_widget_t tipo;
+    retangulo_t area;
+    bool visivel;
+    bool sujo;
+    union {
+        char texto[WIDGET_TEXTO_MAX + 1]; // rótulo e valor
+        uint8_t percentual;               // barra, 0 a 100
+        struct {
+            const uint8_t *bitmap;        // 8 colunas, bit 0 no topo (mesmo formato da fonte)
+            bool ligado;
+        } icone;
+        struct {
+            int16_t *amostras;            // buffer circular fornecido por quem cria o widget
+            uint8_t capacidade;
+            uint8_t inicio;
+            uint8_t quantidade;
+            int16_t faixa_minima;         // evita amplificar ruído quando a série é plana
+        } sparkline;
+    };
+} widget_t;
+
+typedef struct {
+    ssd1306_t *ssd;
+    widget_t *widgets[TELA_MAX_WIDGETS];
+    uint8_t num_widgets;
+    retangulo_t danos[TELA_MAX_DANOS];
+    uint8_t num_danos;
+    uint32_t bytes_enviados; // total enviado por tela_enviar, para diagnóstico
+} tela_t;
+
+void widget_rotulo(widget_t *w, uint8_t x, uint8_t y, const char *texto);
+void widget_valor(widget_t *w, uint8_t x, uint8_t y, uint8_t caracteres);
+void widget_barra(widget_t *w, uint8_t x, uint8_t y, uint8_t largura, uint8_t altura);
+void widget_icone(widget_t *w, uint8_t x, uint8_t y, const uint8_t *bitmap);
+void widget_sparkline(widget_t *w, uint8_t x, uint8_t y, uint8_t largura, uint8_t altura,
+                      int16_t *amostras, uint8_t capacidade, int16_t faixa_minima);
+
+void widget_texto_definir(widget_t *w, const char *texto);
+void widget_barra_definir(widget_t *w, uint8_t percentual);
+void widget_icone_definir(widget_t *w, bool ligado);
+void widget_sparkline_adicionar(widget_t *w, int16_t amostra);
+void widget_visivel(widget_t *w, bool visivel);
+
+void tela_init(tela_t *tela, ssd1306_t *ssd);
+bool tela_adicionar(tela_t *tela, widget_t *w);
+uint8_t tela_renderizar(tela_t *tela);
+void tela_enviar(tela_t *tela);
+
+#endif
@@ -21,10 +21,11 @@
 #define LWIP_DNS 1
 #define LWIP_HTTPD 1
 #define LWIP_HTTPD_SSI              1  
-#define LWIP_HTTPD_SUPPORT_POST     1  
+#define LWIP_HTTPD_SSI_INCLUDE_TAG  0  // envia só o valor, sem repetir o comentário da tag
+#define LWIP_HTTPD_SUPPORT_POST     0  // comandos chegam por GET (CGI)
 #define LWIP_HTTPD_DYNAMIC_HEADERS 1
-#define HTTPD_USE_CUSTOM_FSDATA 0
-#define LWIP_HTTPD_CGI 0           
+#define HTTPD_FSDATA_FILE "generated/fsdata_painel.c" // gerado por tools/makefsdata.py a partir de web/
+#define LWIP_HTTPD_CGI 1           
 #define LWIP_NETIF_HOSTNAME 1
 
 #endif 
\ No newline at end of file
@@ -5,18 +5,27 @@
 #include <stdio.h>                     // biblioteca padrão para entrada/saída
 #include <string.h>                    // manipulação de strings 
 #include <stdlib.h>                    // funções padrão 
+#include <ctype.h>                     // isdigit para validar números do Serial Monitor
 #include "pico/stdlib.h"               // funções básicas do Pico SDK 
 #include "hardware/gpio.h"             // controle de GPIOs 
 #include "hardware/i2c.h"              // comunicação I2C para o display OLED
 #include "hardware/adc.h"              // leitura do ADC para sensor de temperatura interno
+#include "hardware/sync.h"             // barreiras de memória para publicar estado à rede
 #include "pico/cyw43_arch.h"           // suporte ao módulo Wi-Fi CYW43439
-#include "lwip/pbuf.h"                 // /buffers de dados para comunicação TCP
-#include "lwip/tcp.h"                  // protocolo TCP para implementar o webserver
 #include "lwip/netif.h"                // interface de rede para obter endereço IP
+#include "lwip/apps/httpd.h"           // servidor HTTP do lwIP (páginas em generated/fsdata_painel.c)
 #include "generated/ws2812.pio.h"      // controlar matriz WS2812
 #include "lib/ssd1306.h"               // biblioteca para display OLED SSD1306
-
-// credenciais Wi-Fi
+#include "lib/widgets.h"               // widgets retidos com redesenho parcial do OLED
+#include "lib/pwm_saidas.h"            // PWM para LED RGB e buzzer
+#include "lib/fila_comandos.h"         // fila sem trava de comandos vindos da rede
+#include "lib/estado.h"                // estado central versionado com assinantes
+#include "lib/supervisor_wifi.h"       // conexão Wi-Fi com reconexão automática
+#include "lib/config_painel.h"         // configurações persistentes na flash
+#include "lib/telemetria.h"            // telemetria em lote por UDP
+#include "lib/energia.h"               // modo de baixo consumo e espera por eventos
+
+// credenciais Wi-Fi padrão (valem até outras serem gravadas na flash pelo Serial Monitor)
 #define WIFI_SSID "Apartamento 01"     // SSID (nome) da rede Wi-Fi 
 #define WIFI_PASSWORD "12345678"       // senha da rede Wi-Fi
 
@@ -35,17 +44,93 @@
 #define JOYSTICK 22                    // GPIO para botão do joystick (muda cor)
 #define WIDTH 128                      // largura do display OLED 
 #define HEIGHT 64                      // altura do display OLED 
-
-// variáveis globais
-typedef enum { VERMELHO, VERDE, AZUL, AMARELO, CIANO, LILAS } Cor; // enum para representar cores do LED RGB
-static Cor cor_atual = VERMELHO; // cor inicial do LED RGB 
-static bool led_ligado = false; // estado do LED RGB e matriz (desligado)
-static bool emergencia = false; // estado do modo de emergência (desativado)
+#define FADE_LED_MS 300                // duração da transição de cor do LED RGB
+#define DEBOUNCE_MS 200                // intervalo mínimo entre toques aceitos nos botões
+#define HISTORICO_AMOSTRAS 42          // amostras de temperatura no gráfico do OLED
+#define HISTORICO_INTERVALO_MS 5000    // intervalo entre amostras do gráfico (~3,5 min visíveis)
+#define TELEMETRIA_PORTA 5005          // porta UDP padrão do coletor de telemetria
+#define TELEMETRIA_INTERVALO_MS 5000   // intervalo padrão entre lotes de telemetria
+
+// variáveis globais (o estado do painel fica em lib/estado)
 static ssd1306_t disp; // estrutura para controlar o display OLED 
+static uint32_t ultimo_historico = 0; // timestamp da última amostra do gráfico de temperatura
 static uint32_t ultima_leitura_temperatura = 0; // timestamp da última leitura de temperatura
-static uint32_t ultimo_botao = 0; // timestamp da última verificação de botões
-static uint32_t ultima_atualizacao_oled = 0; // timestamp da última atualização do OLED
-static uint32_t ultimo_buzzer = 0; // timestamp da última alternância do buzzer
+static uint32_t ultimo_botao = 0; // timestamp do último toque aceito (debounce)
+static uint32_t ultimo_relatorio = 0; // timestamp do último relatório de renders
+
+// inicialização em etapas: a rede conecta em segundo plano enquanto o painel já opera
+static bool servidor_ativo = false; // servidor HTTP escutando (sobrevive às reconexões)
+static bool boot_relatado = false; // tempos de boot já impressos
+
+// instantes do boot em microssegundos, para medir o tempo de inicialização
+static struct {
+    uint64_t primeiro_quadro_us; // primeiro quadro completo no OLED
+    uint64_t seguranca_us; // monitoramento de temperatura e alarme ativos
+    uint64_t http_pronto_us; // servidor HTTP escutando
+} tempos_boot;
+
+// estado do painel como visto pelos callbacks de rede (contexto de IRQ)
+typedef struct {
+    bool led_ligado; // estado do LED
+    Cor cor; // cor atual
+    bool emergencia; // estado da emergência
+    float temperatura; // última temperatura lida
+    uint32_t comandos_aplicados; // comandos da fila já incorporados a este estado
+} visao_painel_t;
+static fila_comandos_t fila_rede; // comandos HTTP enfileirados para o loop principal
+static visao_painel_t visoes[2]; // buffer duplo escrito pelo loop principal
+static volatile uint8_t visao_ativa = 0; // índice da visão publicada
+static visao_painel_t visao_projetada; // visão publicada + comandos ainda na fila (só a rede usa)
+static uint32_t comandos_enviados = 0; // comandos enfileirados (só a rede escreve)
+static uint32_t comandos_aplicados = 0; // comandos consumidos (só o loop principal escreve)
+
+// rotas de comando atendidas por CGI (formulários de web/index.shtml)
+static const struct {
+    const char *caminho; // URI do formulário
+    comando_t comando; // comando enfileirado para o loop principal
+} rotas_comando[] = {
+    {"/led_on",       {CMD_LED_LIGAR, 0}},
+    {"/led_off",      {CMD_LED_DESLIGAR, 0}},
+    {"/color_red",    {CMD_COR, VERMELHO}},
+    {"/color_green",  {CMD_COR, VERDE}},
+    {"/color_blue",   {CMD_COR, AZUL}},
+    {"/color_yellow", {CMD_COR, AMARELO}},
+    {"/color_cyan",   {CMD_COR, CIANO}},
+    {"/color_lilas",  {CMD_COR, LILAS}},
+    {"/alarm_off",    {CMD_ALARME_DESLIGAR, 0}}
+};
+static tCGI cgis[count_of(rotas_comando)]; // tabela registrada no httpd
+
+// tags SSI de web/index.shtml, na ordem tratada por ssi_painel
+static const char *tags_ssi[] = {"led", "cor", "temp", "emerg"};
+
+// widgets do display OLED
+static tela_t tela; // conjunto de widgets e áreas danificadas
+static widget_t w_alerta; // ícone de emergência
+static widget_t w_temperatura; // texto da temperatura
+static widget_t w_emergencia; // texto do estado da emergência
+static widget_t w_historico; // gráfico da temperatura recente
+static widget_t w_rotulo_ip; // rótulo do endereço IP
+static widget_t w_ip; // endereço IP
+static widget_t w_progresso; // progresso da conexão Wi-Fi (ocupa o lugar do IP)
+static int16_t historico_temperatura[HISTORICO_AMOSTRAS]; // amostras em centésimos de °C
+static const uint8_t icone_alerta[8] = {0x7E, 0xFF, 0xFF, 0xA1, 0xA1, 0xFF, 0xFF, 0x7E}; // "!" vazado em bloco
+
+// cores do LED RGB em 8 bits por canal, na ordem do enum Cor
+static const uint8_t paleta_rgb[6][3] = {
+    {255, 0,   0},   // Vermelho
+    {0,   255, 0},   // Verde
+    {0,   0,   255}, // Azul
+    {255, 160, 0},   // Amarelo
+    {0,   255, 255}, // Ciano
+    {160, 0,   255}  // Lilás
+};
+
+// padrão do alarme de emergência: 1s de tom, 1s de silêncio
+static const passo_buzzer_t alarme_emergencia[] = {
+    {2000, 1000}, // tom de 2kHz por 1s
+    {0,    1000}  // silêncio por 1s
+};
 
 // padrões da matriz de LEDs
 static const int pixel_map[5][5] = { // mapeamento de índices da matriz WS2812
@@ -71,22 +156,51 @@ static const uint8_t padrao_exclamacao[5][5] = { // padrão "!" para emergência
 };
 
 // protótipos de funções
-void inicializar_perifericos(void); // inicializa GPIOs para LED RGB, botões, e buzzer
+void inicializar_perifericos(void); // inicializa GPIOs dos botões e PWM do LED RGB e buzzer
+static void botao_irq(uint gpio, uint32_t eventos); // acorda o loop quando um botão muda
 float ler_temperatura(void); // lê temperatura do sensor interno via ADC
 void configurar_led_rgb(Cor cor, bool estado); // configura LED RGB com cor e estado
 void configurar_matriz(const uint8_t padrao[5][5], uint8_t r, uint8_t g, uint8_t b); // configura matriz WS2812
-static err_t tcp_server_accept(void *arg, struct tcp_pcb *newpcb, err_t err); // aceita conexões TCP
-static err_t tcp_server_recv(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, err_t err); // processa requisições HTTP
-void processar_requisicao(char **requisicao); // interpreta comandos HTTP
-void atualizar_display(void); // atualiza display OLED com informações do sistema
+static const char *cgi_comando(int indice, int num_parametros, char *parametros[], char *valores[]); // enfileira comando de uma rota
+static u16_t ssi_painel(int indice, char *insercao, int tamanho); // preenche tags SSI com o estado
+void aplicar_comando(comando_t comando); // aplica comando da rede ao estado do painel
+void projetar_comando(visao_painel_t *visao, comando_t comando); // aplica comando a uma visão do estado
+void publicar_visao(void); // publica o estado atual para os callbacks de rede
+void configurar_tela(void); // cria os widgets do display OLED
+void atualizar_display(void); // atualiza widgets do OLED com o estado do sistema
+void monitorar_temperatura(uint32_t agora); // lê temperatura e aplica a regra de emergência
+void evento_wifi(estado_wifi_t estado, int status_link); // reage a mudanças da conexão Wi-Fi
+void iniciar_servidor(void); // inicia o httpd na porta 80
+void exibir_status_rede(const char *texto, uint8_t percentual); // mostra progresso da conexão no OLED
+void exibir_ip(void); // mostra o IP obtido no OLED
+void relatar_boot(void); // imprime os tempos de inicialização
+void ler_comando_serial(void); // lê comandos de configuração do Serial Monitor sem bloquear
+void executar_comando_serial(const char *linha); // aplica um comando de configuração
+static void render_led_rgb(const estado_t *estado, uint32_t campos); // saída: LED RGB
+static void render_matriz(const estado_t *estado, uint32_t campos); // saída: matriz WS2812
+static void render_buzzer(const estado_t *estado, uint32_t campos); // saída: buzzer
+static void render_oled(const estado_t *estado, uint32_t campos); // saída: display OLED
+static void render_rede(const estado_t *estado, uint32_t campos); // saída: visão publicada aos clientes HTTP
+static void render_config(const estado_t *estado, uint32_t campos); // saída: configurações persistentes
+static void render_telemetria(const estado_t *estado, uint32_t campos); // saída: lote de telemetria UDP
+
+// saídas e os campos do estado de que dependem
+static assinante_t assinantes[] = {
+    {.nome = "LED",    .mascara = CAMPO_LIGADO | CAMPO_COR | CAMPO_EMERGENCIA, .render = render_led_rgb},
+    {.nome = "Matriz", .mascara = CAMPO_LIGADO | CAMPO_COR | CAMPO_EMERGENCIA, .render = render_matriz},
+    {.nome = "Buzzer", .mascara = CAMPO_EMERGENCIA,                            .render = render_buzzer},
+    {.nome = "OLED",   .mascara = CAMPO_TEMPERATURA | CAMPO_EMERGENCIA,        .render = render_oled},
+    {.nome = "HTTP",   .mascara = CAMPO_TODOS,                                 .render = render_rede},
+    {.nome = "Flash",  .mascara = CAMPO_LIGADO | CAMPO_COR,                    .render = render_config},
+    {.nome = "UDP",    .mascara = CAMPO_TODOS,                                 .render = render_telemetria}
+};
 
 // função principal
 int main() {
-    stdio_init_all(); // inicializa UART para logs no Serial Monitor 
-    sleep_ms(2000); // aguarda 2 segundos para estabilizar a inicialização
+    stdio_init_all(); // inicializa UART para logs no Serial Monitor (sem espera: o boot não bloqueia)
 
-    // inicializa periféricos
-    inicializar_perifericos(); // configura GPIOs para LED RGB, botões, e buzzer
+    // etapa 1: periféricos locais
+    inicializar_perifericos(); // configura botões e PWM do LED RGB e buzzer
     adc_init(); // inicializa módulo ADC para leitura de temperatura
     adc_set_temp_sensor_enabled(true); // ativa sensor de temperatura interno do RP2040
 
@@ -96,54 +210,49 @@ int main() {
     gpio_set_function(I2C_SCL, GPIO_FUNC_I2C); // define pino SCL como função I2C
     gpio_pull_up(I2C_SDA); // habilita pull-up interno para SDA
     gpio_pull_up(I2C_SCL); // habilita pull-up interno para SCL
-    sleep_ms(500); // aguarda 500ms para estabilizar I2C
     ssd1306_init(&disp, WIDTH, HEIGHT, false, OLED_ADDRESS, I2C_PORT); // inicializa estrutura do OLED
     ssd1306_config(&disp); // configura parâmetros do display OLED
     ssd1306_fill(&disp, 0); // limpa o buffer do display 
     ssd1306_send_data(&disp); // envia buffer inicial ao OLED
+    configurar_tela(); // cria widgets (desenhados no primeiro despacho)
 
     // inicializa WS2812
     PIO pio = pio0; // usa PIO0 para controlar a matriz WS2812
     uint offset = pio_add_program(pio, &ws2812_program); // carrega programa PIO para WS2812
     ws2812_program_init(pio, 0, offset, WS2812_PIN, 800000, false); // inicializa WS2812 
 
-    // inicializa Wi-Fi
-    if (cyw43_arch_init()) { // innicializa módulo Wi-Fi CYW43439
-        printf("Falha na inicialização do Wi-Fi\n"); // loga erro no Serial Monitor
-        return -1; // encerra programa em caso de falha
-    }
-    cyw43_arch_enable_sta_mode(); // ativa modo estação (cliente Wi-Fi)
-    printf("Conectando ao Wi-Fi...\n"); // loga tentativa de conexão
-    if (cyw43_arch_wifi_connect_timeout_ms(WIFI_SSID, WIFI_PASSWORD, CYW43_AUTH_WPA2_AES_PSK, 20000)) { // tenta conectar com timeout de 20s
-        printf("Falha na conexão Wi-Fi\n"); // loga erro se a conexão falhar
-        return -1; // encerra programa em caso de falha
-    }
-    printf("Conectado ao Wi-Fi\n"); // confirma conexão bem-sucedida
-    if (netif_default) { // verifica se a interface de rede está ativa
-        printf("IP: %s\n", ipaddr_ntoa(&netif_default->ip_addr)); // exibe endereço IP no Serial Monitor
+    // etapa 2: estado inicial, saídas assinantes e primeiro quadro
+    config_painel_init(&(config_painel_t){ // padrões, substituídos pelo que foi gravado na flash
+        .cor = VERMELHO, .led_ligado = false, .limite_temperatura = 40.0f,
+        .ssid = WIFI_SSID, .senha = WIFI_PASSWORD,
+        .coletor_ip = 0, .coletor_porta = TELEMETRIA_PORTA, .telemetria_intervalo_ms = TELEMETRIA_INTERVALO_MS
+    });
+    telemetria_configurar(config_painel()->coletor_ip, config_painel()->coletor_porta, config_painel()->telemetria_intervalo_ms); // sem coletor: desligada
+    estado_init(&(estado_t){config_painel()->led_ligado, config_painel()->cor, false, 0.0f}); // cor e LED da última sessão, sem emergência
+    for (size_t i = 0; i < count_of(assinantes); i++) { // registra cada saída no estado
+        estado_assinar(&assinantes[i]);
     }
+    estado_despachar(); // primeiro render de todas as saídas
+    tela_renderizar(&tela); // desenha todos os widgets
+    tela_enviar(&tela); // envia o primeiro quadro
+    tempos_boot.primeiro_quadro_us = time_us_64(); // marca tempo até o primeiro quadro
 
-    // configura servidor TCP
-    struct tcp_pcb *server = tcp_new(); // cria um novo PCB (Protocol Control Block) para o webserver
-    if (!server) { // verifica se a criação do PCB falhou
-        printf("Falha na criação do servidor TCP\n"); // loga erro
-        return -1; // encerra programa em caso de falha
-    }
-    if (tcp_bind(server, IP_ADDR_ANY, 80) != ERR_OK) { // associa o servidor à porta 80 (HTTP)
-        printf("Falha no bind TCP\n"); // loga erro se o bind falhar
-        return -1; // encerra programa em caso de falha
-    }
-    server = tcp_listen(server); // coloca o servidor em modo escuta
-    tcp_accept(server, tcp_server_accept); // define callback para aceitar conexões
-    printf("Servidor escutando na porta 80\n\n"); // loga que o servidor está ativo
+    // etapa 3: lógica de segurança ativa antes de qualquer espera pela rede
+    monitorar_temperatura(to_ms_since_boot(get_absolute_time())); // primeira leitura e regra de emergência
+    estado_despachar(); // dispara alarme imediatamente se necessário
+    tempos_boot.seguranca_us = time_us_64(); // marca tempo até a segurança ativa
+
+    // etapa 4: o Wi-Fi é iniciado pelo loop e conecta de forma assíncrona (supervisor_wifi)
+    supervisor_wifi_init(config_painel()->ssid, config_painel()->senha, CYW43_AUTH_WPA2_AES_PSK, evento_wifi); // reconecta sozinho se o link cair
 
-    // loop principal
+    // loop principal (a rede roda em segundo plano via IRQ, sem cyw43_arch_poll)
     while (true) {
-        cyw43_arch_poll(); // processa eventos de rede (lwIP) para manter o webserver ativo
         uint32_t agora = to_ms_since_boot(get_absolute_time()); // obtém tempo atual em milissegundos
+        uint32_t inicio_passada = time_us_32(); // mede a duração da passada para a telemetria
 
-        // verifica botões a cada 10ms
-        if (agora - ultimo_botao >= 10) { // verifica botões a cada 10ms para responsividade
+        // verifica botões a cada passada (as bordas acordam o loop via IRQ)
+        bool botao_atendido = false; // algum toque mudou o estado nesta passada
+        if (agora - ultimo_botao >= DEBOUNCE_MS) { // ignora repiques logo após um toque aceito
             static bool botao_joystick_pressionado = false; // estado anterior do joystick
             static bool botao_a_pressionado = false; // estado anterior do Botão A
             static bool botao_b_pressionado = false; // estado anterior do Botão B
@@ -154,89 +263,98 @@ int main() {
 
             // joystick: alterna cores
             if (estado_joystick && !botao_joystick_pressionado) { // detecta pressão do joystick
-                cor_atual = (cor_atual + 1) % 6; // cicla para a próxima cor (0 a 5)
+                Cor cor = (estado_atual()->cor + 1) % 6; // cicla para a próxima cor (0 a 5)
+                estado_definir_cor(cor); // atualiza estado
                 printf("Botão Joystick: cor alterada para %s\n\n", // loga a nova cor
-                       cor_atual == VERMELHO ? "vermelho" :
-                       cor_atual == VERDE ? "verde" :
-                       cor_atual == AZUL ? "azul" :
-                       cor_atual == AMARELO ? "amarelo" :
-                       cor_atual == CIANO ? "ciano" : "lilás");
+                       cor == VERMELHO ? "vermelho" :
+                       cor == VERDE ? "verde" :
+                       cor == AZUL ? "azul" :
+                       cor == AMARELO ? "amarelo" :
+                       cor == CIANO ? "ciano" : "lilás");
                 botao_joystick_pressionado = true; // marca joystick como pressionado
-                sleep_ms(200); // debounce de 200ms para evitar múltiplas leituras
+                ultimo_botao = agora; // debounce de 200ms sem bloquear o loop
+                botao_atendido = true;
             } else if (!estado_joystick) { // joystick liberado
                 botao_joystick_pressionado = false; // reseta estado do joystick
             }
 
             // botão A: liga/desliga LED
             if (estado_botao_a && !botao_a_pressionado) { // detecta pressão do Botão A
-                led_ligado = !led_ligado; // alterna estado do LED (ligado/desligado)
-                printf("Botão A: led %s\n\n", led_ligado ? "ligado" : "desligado"); // loga ação
+                estado_definir_ligado(!estado_atual()->led_ligado); // alterna estado do LED (ligado/desligado)
+                printf("Botão A: led %s\n\n", estado_atual()->led_ligado ? "ligado" : "desligado"); // loga ação
                 botao_a_pressionado = true; // marca Botão A como pressionado
-                sleep_ms(200); // debounce de 200ms
+                ultimo_botao = agora; // debounce de 200ms
+                botao_atendido = true;
             } else if (!estado_botao_a) { // botão A liberado
                 botao_a_pressionado = false; // reeseta estado do Botão A
             }
 
             // botão B: desliga emergência
             if (estado_botao_b && !botao_b_pressionado) { // detecta pressão do Botão B
-                emergencia = false; // desativa modo de emergência
+                estado_definir_emergencia(false); // desativa modo de emergência
                 printf("Botão B: alarme desligado\n\n"); // loga ação
                 botao_b_pressionado = true; // marca Botão B como pressionado
-                sleep_ms(200); // debounce de 200ms
+                ultimo_botao = agora; // debounce de 200ms
+                botao_atendido = true;
             } else if (!estado_botao_b) { // botão B liberado
                 botao_b_pressionado = false; // reseta estado do Botão B
             }
+        }
+
+        // comandos de configuração digitados no Serial Monitor
+        ler_comando_serial(); // não bloqueia se nada chegou
 
-            ultimo_botao = agora; // atualiza timestamp da verificação de botões
+        // aplica comandos recebidos pela rede
+        comando_t comando; // comando retirado da fila
+        uint32_t aplicados_antes = comandos_aplicados; // para saber se algo foi consumido
+        while (fila_comandos_receber(&fila_rede, &comando)) { // consome todos os comandos pendentes
+            aplicar_comando(comando); // atualiza estado do painel
+            comandos_aplicados++; // conta comando consumido
+        }
+        if (comandos_aplicados != aplicados_antes) { // mesmo comandos sem efeito precisam ser confirmados à rede
+            publicar_visao(); // rede volta a usar o estado publicado
         }
 
         // lê temperatura a cada 1000ms
         if (agora - ultima_leitura_temperatura >= 1000) { // verifica temperatura a cada 1s
-            float temperatura = ler_temperatura(); // lê temperatura do sensor interno
-            if (temperatura > 40.0f) { // ee temperatura exceder 40°C
-                emergencia = true; // ativa modo de emergência
-            }
-            ultima_leitura_temperatura = agora; // atualiza timestamp da leitura
+            monitorar_temperatura(agora); // atualiza temperatura e emergência
         }
 
-        // atualiza display a cada 1000ms
-        if (agora - ultima_atualizacao_oled >= 1000) { // atualiza OLED a cada 1s
-            atualizar_display(); // exibe temperatura, emergência e IP no OLED
-            ultima_atualizacao_oled = agora; // atualiza timestamp do OLED
-        }
+        // conexão Wi-Fi e servidor HTTP avançam sem bloquear o loop
+        supervisor_wifi_atualizar(agora); // consulta status do link e reconecta com backoff
+        energia_atualizar(agora, supervisor_wifi_estado() == WIFI_CONECTADO); // power save do rádio sem clientes
 
-        // controla buzzer em emergência
-        if (emergencia && agora - ultimo_buzzer >= 1000) { // se emergência ativa, alterna buzzer a cada 1s
-            gpio_put(BUZZER, !gpio_get(BUZZER)); // inverte estado do buzzer (liga/desliga)
-            ultimo_buzzer = agora; // atualiza timestamp do buzzer
-        } else if (!emergencia && gpio_get(BUZZER)) { // se emergência desativada e buzzer ligado
-            gpio_put(BUZZER, 0); // desliga buzzer
+        // redesenha apenas as saídas cujos campos mudaram
+        estado_despachar(); // LED, matriz, buzzer, OLED e visão HTTP
+        if (tela_renderizar(&tela)) { // widgets alterados geraram áreas danificadas
+            tela_enviar(&tela); // envia ao OLED só essas regiões
         }
-
-        // atualiza LED RGB e matriz
-        if (!emergencia) { // se não estiver em emergência
-            configurar_led_rgb(cor_atual, led_ligado); // configura LED RGB com cor atual e estado
-        } else { // em emergência
-            configurar_led_rgb(cor_atual, false); // desliga LED RGB
+        energia_concluir(ORIGEM_BOTAO, botao_atendido); // latência da borda até as saídas atualizadas
+        energia_concluir(ORIGEM_HTTP, comandos_aplicados != aplicados_antes); // latência do CGI até as saídas
+        config_painel_persistir(agora, false); // grava cor/LED quando a sequência de alterações termina
+        telemetria_atualizar(agora, supervisor_wifi_estado() == WIFI_CONECTADO); // envia o lote quando o intervalo vence
+
+        // relatório de trabalho evitado a cada 60s
+        if (agora - ultimo_relatorio >= 60000) { // imprime contadores de render
+            estado_relatorio(); // renders/despachos por saída
+            printf("OLED: %lu bytes enviados\n", (unsigned long)tela.bytes_enviados); // tráfego I2C de imagem
+            supervisor_wifi_relatorio(); // quedas e tempos de reconexão
+            config_painel_relatorio(); // gravações e compactações do log na flash
+            telemetria_relatorio(); // lotes enviados e perdidos
+            energia_relatorio(); // despertares e latências por modo
+            ultimo_relatorio = agora; // atualiza timestamp do relatório
         }
-        if (emergencia) { // se emergência ativa
-            configurar_matriz(padrao_exclamacao, 32, 0, 0); // exibe padrão "!" em vermelho
-        } else if (led_ligado) { // se LED ligado e sem emergência
-            uint8_t r = 0, g = 0, b = 0; // inicializa componentes RGB
-            switch (cor_atual) { // define valores RGB com base na cor atual
-                case VERMELHO: r = 32; break; // Vermelho
-                case VERDE: g = 32; break; // Verde
-                case AZUL: b = 32; break; // Azul
-                case AMARELO: r = 32; g = 32; break; // Amarelo
-                case CIANO: g = 32; b = 32; break; // Ciano
-                case LILAS: r = 32; b = 32; break; // Lilás
+
+        telemetria_passada(time_us_32() - inicio_passada); // trabalho útil da passada, sem a espera
+
+        // dorme até a cadência do modo, a próxima tarefa ou um evento
+        uint32_t proxima_tarefa = ultima_leitura_temperatura + 1000; // leitura de temperatura nunca atrasa
+        if (agora - ultimo_botao < DEBOUNCE_MS) { // toque recente: reavalia os botões no fim do debounce
+            if ((int32_t)(ultimo_botao + DEBOUNCE_MS - proxima_tarefa) < 0) {
+                proxima_tarefa = ultimo_botao + DEBOUNCE_MS;
             }
-            configurar_matriz(padrao_V, r, g, b); // exibe padrão "V" na cor atual
-        } else { // se LED desligado
-            configurar_matriz(padrao_V, 0, 0, 0); // desliga matriz 
         }
-
-        sleep_ms(10); // delay de 10ms para evitar sobrecarga do loop
+        energia_aguardar(agora, proxima_tarefa); // WFE entre IRQs, em vez de sleep_ms(10)
     }
 
     cyw43_arch_deinit(); // desinicializa Wi-Fi 
@@ -245,15 +363,7 @@ int main() {
 
 // inicializa periféricos
 void inicializar_perifericos(void) {
-    gpio_init(LED_R); // inicializa GPIO do LED vermelho
-    gpio_set_dir(LED_R, GPIO_OUT); // define como saída
-    gpio_put(LED_R, 0); // desliga LED vermelho
-    gpio_init(LED_G); // inicializa GPIO do LED verde
-    gpio_set_dir(LED_G, GPIO_OUT); // define como saída
-    gpio_put(LED_G, 0); // desliga LED verde
-    gpio_init(LED_B); // inicializa GPIO do LED azul
-    gpio_set_dir(LED_B, GPIO_OUT); // define como saída
-    gpio_put(LED_B, 0); // desliga LED azul
+    pwm_saidas_init(LED_R, LED_G, LED_B, BUZZER); // LED RGB e buzzer via PWM, iniciam desligados
     gpio_init(JOYSTICK); // inicializa GPIO do joystick
     gpio_set_dir(JOYSTICK, GPIO_IN); // define como entrada
     gpio_pull_up(JOYSTICK); // habilita pull-up interno
@@ -263,9 +373,32 @@ void inicializar_perifericos(void) {
     gpio_init(BUTTON_B); // inicializa GPIO do Botão B
     gpio_set_dir(BUTTON_B, GPIO_IN); // define como entrada
     gpio_pull_up(BUTTON_B); // habilita pull-up interno
-    gpio_init(BUZZER); // inicializa GPIO do buzzer
-    gpio_set_dir(BUZZER, GPIO_OUT); // define como saída
-    gpio_put(BUZZER, 0); // desliga buzzer
+    gpio_set_irq_enabled_with_callback(JOYSTICK, GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE, true, botao_irq); // toque e soltura acordam o loop
+    gpio_set_irq_enabled(BUTTON_A, GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE, true); // mesmo callback
+    gpio_set_irq_enabled(BUTTON_B, GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE, true); // mesmo callback
+}
+
+// acorda o loop quando um botão muda; o toque marca o início da medição de latência (contexto de IRQ)
+static void botao_irq(uint gpio, uint32_t eventos) {
+    if (eventos & GPIO_IRQ_EDGE_FALL) { // botão pressionado (pull-up)
+        energia_evento(ORIGEM_BOTAO);
+    } else { // soltura: o loop precisa vê-la para aceitar o próximo toque
+        energia_acordar();
+    }
+}
+
+// lê temperatura e aplica a regra de emergência
+void monitorar_temperatura(uint32_t agora) {
+    float temperatura = ler_temperatura(); // lê temperatura do sensor interno
+    estado_definir_temperatura(temperatura); // só marca o campo se a leitura mudou
+    if (temperatura > config_painel()->limite_temperatura) { // se temperatura exceder o limite (40°C por padrão)
+        estado_definir_emergencia(true); // ativa modo de emergência
+    }
+    if (ultimo_historico == 0 || agora - ultimo_historico >= HISTORICO_INTERVALO_MS) { // nova amostra do gráfico
+        widget_sparkline_adicionar(&w_historico, (int16_t)(temperatura * 100)); // redesenha só o gráfico
+        ultimo_historico = agora; // atualiza timestamp do gráfico
+    }
+    ultima_leitura_temperatura = agora; // atualiza timestamp da leitura
 }
 
 // lê temperatura do sensor interno
@@ -279,20 +412,11 @@ float ler_temperatura(void) {
 
 // configura LED RGB
 void configurar_led_rgb(Cor cor, bool estado) {
-    uint8_t r = 0, g = 0, b = 0; // inicializa componentes RGB como 0 
     if (estado) { // se LED deve estar ligado
-        switch (cor) { // define valores RGB com base na cor
-            case VERMELHO: r = 32; break; // Vermelho
-            case VERDE: g = 32; break; // Verde
-            case AZUL: b = 32; break; // Azul
-            case AMARELO: r = 32; g = 32; break; // Amarelo
-            case CIANO: g = 32; b = 32; break; // Ciano
-            case LILAS: r = 32; b = 32; break; // Lilás
-        }
+        rgb_pwm_fade(paleta_rgb[cor][0], paleta_rgb[cor][1], paleta_rgb[cor][2], FADE_LED_MS); // transição até a cor
+    } else { // LED desligado
+        rgb_pwm_fade(0, 0, 0, FADE_LED_MS); // apaga suavemente
     }
-    gpio_put(LED_R, r > 0); // Liga/desliga vermelho
-    gpio_put(LED_G, g > 0); // Liga/desliga verde
-    gpio_put(LED_B, b > 0); // Liga/desliga azul
 }
 
 // configura matriz de LEDs
@@ -310,131 +434,346 @@ void configurar_matriz(const uint8_t padrao[5][5], uint8_t r, uint8_t g, uint8_t
     }
 }
 
-// callback de aceitação de conexão TCP
-static err_t tcp_server_accept(void *arg, struct tcp_pcb *newpcb, err_t err) {
-    tcp_recv(newpcb, tcp_server_recv); // define callback para processar requisições recebidas
-    return ERR_OK; // aceita conexão
+// reage a mudanças da conexão Wi-Fi (chamado pelo supervisor)
+void evento_wifi(estado_wifi_t estado, int status_link) {
+    switch (estado) {
+        case WIFI_CONECTANDO: // associação e DHCP em andamento
+            if (status_link == CYW43_LINK_JOIN) { // associado ao ponto de acesso
+                exibir_status_rede("ASSOCIANDO...", 50);
+            } else if (status_link == CYW43_LINK_NOIP) { // aguardando DHCP
+                exibir_status_rede("OBTENDO IP...", 75);
+            } else if (status_link == CYW43_LINK_DOWN) { // tentativa iniciada
+                printf("Conectando ao Wi-Fi...\n"); // loga tentativa de conexão
+                exibir_status_rede(servidor_ativo ? "RECONECTANDO" : "CONECTANDO...", 25);
+            } // falhas (FAIL, NONET, BADAUTH) aparecem em seguida como WIFI_AGUARDANDO
+            return; // boot ainda não terminou
+        case WIFI_CONECTADO: // conectado com IP (inclusive após queda)
+            printf("Conectado ao Wi-Fi\n"); // confirma conexão bem-sucedida
+            exibir_ip(); // anuncia o endereço atual no OLED
+            if (!servidor_ativo) { // o httpd escuta em IP_ADDR_ANY e continua válido nas reconexões
+                iniciar_servidor(); // páginas, SSI e CGI
+                servidor_ativo = true; // não recria nas próximas conexões
+                tempos_boot.http_pronto_us = time_us_64(); // marca tempo até o HTTP pronto
+                if (boot_relatado) { // boot já relatado sem rede (primeira tentativa falhou)
+                    printf("Boot: HTTP pronto %lu ms\n\n", (unsigned long)(tempos_boot.http_pronto_us / 1000));
+                }
+            }
+            break;
+        case WIFI_AGUARDANDO: // tentativa falhou, aguardando backoff
+            exibir_status_rede("SEM WI-FI", 0); // mostra falha no OLED
+            break;
+        case WIFI_AUSENTE: // rádio não inicializou
+            exibir_status_rede("WI-FI AUSENTE", 0); // painel segue sem rede
+            break;
+        default:
+            return;
+    }
+    if (!boot_relatado) { // primeira conclusão do boot, com ou sem rede
+        relatar_boot(); // imprime tempos de inicialização
+        boot_relatado = true;
+    }
+}
+
+// inicia o httpd na porta 80
+void iniciar_servidor(void) {
+    for (size_t i = 0; i < count_of(rotas_comando); i++) { // uma rota CGI por comando
+        cgis[i] = (tCGI){rotas_comando[i].caminho, cgi_comando};
+    }
+    cyw43_arch_lwip_begin(); // protege o lwIP do contexto de rede em segundo plano
+    http_set_cgi_handlers(cgis, count_of(cgis)); // comandos dos formulários
+    http_set_ssi_handler(ssi_painel, tags_ssi, count_of(tags_ssi)); // valores dinâmicos da página
+    httpd_init(); // escuta na porta 80 servindo o sistema de arquivos gerado
+    cyw43_arch_lwip_end(); // libera o lwIP
+    printf("Servidor escutando na porta 80\n\n"); // loga que o servidor está ativo
+}
+
+// mostra progresso da conexão no OLED no lugar do IP
+void exibir_status_rede(const char *texto, uint8_t percentual) {
+    widget_texto_definir(&w_rotulo_ip, texto); // etapa atual na linha 3
+    widget_texto_definir(&w_ip, "N/A"); // IP anterior deixa de valer
+    widget_barra_definir(&w_progresso, percentual); // barra na linha 4
+    widget_visivel(&w_ip, percentual == 0); // sem progresso (falha): mostra "N/A"
+    widget_visivel(&w_progresso, percentual > 0); // durante a conexão: mostra a barra
+}
+
+// mostra o IP obtido no OLED
+void exibir_ip(void) {
+    cyw43_arch_lwip_begin(); // protege acesso à interface de rede
+    if (netif_default) { // verifica se a interface de rede está ativa
+        printf("IP: %s\n", ipaddr_ntoa(&netif_default->ip_addr)); // exibe endereço IP no Serial Monitor
+        widget_texto_definir(&w_ip, ipaddr_ntoa(&netif_default->ip_addr)); // exibe endereço IP no OLED
+    }
+    cyw43_arch_lwip_end(); // libera o lwIP
+    widget_texto_definir(&w_rotulo_ip, "IP P/ CONEXAO:"); // rótulo na linha 3
+    widget_visivel(&w_progresso, false); // esconde a barra
+    widget_visivel(&w_ip, true); // mostra o IP
+}
+
+// imprime os tempos de inicialização
+void relatar_boot(void) {
+    printf("Boot: config restaurada em %lu us, primeiro quadro %lu ms, seguranca ativa %lu ms", // tempos desde o reset
+           (unsigned long)config_painel_tempo_restauracao_us(),
+           (unsigned long)(tempos_boot.primeiro_quadro_us / 1000),
+           (unsigned long)(tempos_boot.seguranca_us / 1000));
+    if (tempos_boot.http_pronto_us) { // HTTP só fica pronto com rede
+        printf(", HTTP pronto %lu ms", (unsigned long)(tempos_boot.http_pronto_us / 1000));
+    }
+    printf("\n\n");
+}
+
+// lê comandos de configuração do Serial Monitor sem bloquear
+void ler_comando_serial(void) {
+    static char linha[80]; // linha sendo digitada
+    static uint8_t tamanho = 0; // caracteres recebidos
+    int c; // caractere lido
+    while ((c = getchar_timeout_us(0)) != PICO_ERROR_TIMEOUT) { // consome só o que já chegou
+        if (c != '\r' && c != '\n') { // ainda na mesma linha
+            if (tamanho < sizeof(linha) - 1) { // descarta o excesso
+                linha[tamanho++] = (char)c;
+            }
+            continue;
+        }
+        linha[tamanho] = '\0'; // fim da linha
+        if (tamanho > 0) { // ignora linhas vazias
+            executar_comando_serial(linha);
+        }
+        tamanho = 0; // começa nova linha
+    }
+}
+
+// aplica um comando de configuração: "limite <graus>", "wifi <ssid>", "senha <senha>",
+// "coletor <ip>[:porta]" ou "telemetria <ms>"
+void executar_comando_serial(const char *linha) {
+    if (strncmp(linha, "limite ", 7) == 0) { // limite de temperatura da emergência
+        char *fim; // primeiro caractere após o número
+        float graus = strtof(linha + 7, &fim); // converte o valor digitado
+        if (fim == linha + 7 || !config_painel_limite_valido(graus)) { // sem número, nan/inf ou fora da faixa
+            printf("Limite invalido (use %.0f a %.0f C)\n\n", CONFIG_LIMITE_MIN, CONFIG_LIMITE_MAX);
+            return;
+        }
+        config_painel_definir_limite(graus); // vale a partir da próxima leitura
+        printf("Config: limite de temperatura %.1fC\n\n", graus);
+    } else if (strncmp(linha, "wifi ", 5) == 0) { // nome da rede
+        config_painel_definir_ssid(linha + 5); // usado na próxima tentativa de conexão
+        printf("Config: SSID \"%s\" (vale na proxima conexao)\n\n", config_painel()->ssid);
+    } else if (strncmp(linha, "senha ", 6) == 0) { // senha da rede
+        config_painel_definir_senha(linha + 6); // usada na próxima tentativa de conexão
+        printf("Config: senha alterada (vale na proxima conexao)\n\n");
+    } else if (strncmp(linha, "coletor ", 8) == 0) { // destino da telemetria (0.0.0.0 desliga)
+        char endereco[24]; // IP sem a porta
+        strncpy(endereco, linha + 8, sizeof(endereco) - 1);
+        endereco[sizeof(endereco) - 1] = '\0';
+        uint16_t porta = config_painel()->coletor_porta; // mantém a porta se não informada
+        char *separador = strchr(endereco, ':'); // "ip:porta"
+        bool porta_valida = true; // porta informada é um número de 1 a 65535
+        if (separador) {
+            *separador = '\0';
+            char *fim; // primeiro caractere após o número
+            unsigned long valor = strtoul(separador + 1, &fim, 10); // sem truncar para 16 bits
+            porta_valida = isdigit((unsigned char)separador[1]) && *fim == '\0' && valor >= 1 && valor <= 65535;
+            porta = (uint16_t)valor;
+        }
+        ip_addr_t ip; // endereço convertido
+        if (!ipaddr_aton(endereco, &ip) || !porta_valida || porta == 0) { // endereço ou porta inválidos
+            printf("Coletor invalido\n\n");
+            return;
+        }
+        config_painel_definir_coletor(ip4_addr_get_u32(&ip), porta); // grava o novo destino
+        telemetria_configurar(config_painel()->coletor_ip, porta, config_painel()->telemetria_intervalo_ms); // passa a valer já
+        printf("Config: coletor de telemetria %s:%u\n\n", endereco, porta);
+    } else if (strncmp(linha, "telemetria ", 11) == 0) { // intervalo entre lotes (0 desliga)
+        char *fim; // primeiro caractere após o número
+        unsigned long intervalo = strtoul(linha + 11, &fim, 10); // converte o valor digitado
+        if (!isdigit((unsigned char)linha[11]) || *fim != '\0') { // não era um número
+            printf("Intervalo invalido (use 0 a %d ms)\n\n", TELEMETRIA_INTERVALO_MAX_MS);
+            return;
+        }
+        if (intervalo > TELEMETRIA_INTERVALO_MAX_MS) { // grava o mesmo valor que a telemetria usa
+            intervalo = TELEMETRIA_INTERVALO_MAX_MS;
+            printf("Intervalo limitado a %d ms\n", TELEMETRIA_INTERVALO_MAX_MS);
+        }
+        config_painel_definir_telemetria((uint32_t)intervalo); // grava o novo intervalo
+        telemetria_configurar(config_painel()->coletor_ip, config_painel()->coletor_porta, config_painel()->telemetria_intervalo_ms); // passa a valer já
+        printf("Config: telemetria a cada %lu ms\n\n", (unsigned long)config_painel()->telemetria_intervalo_ms);
+    } else { // comando desconhecido
+        printf("Comandos: limite <graus>, wifi <ssid>, senha <senha>, coletor <ip>[:porta], telemetria <ms>\n\n");
+        return;
+    }
+    config_painel_persistir(to_ms_since_boot(get_absolute_time()), true); // configuração manual é gravada na hora
+}
+
+// aplica comando da rede ao estado do painel (executado no loop principal)
+void aplicar_comando(comando_t comando) {
+    static const char *nomes_cores[] = {"vermelho", "verde", "azul", "amarelo", "ciano", "lilás"}; // nomes para log
+    switch (comando.tipo) {
+        case CMD_LED_LIGAR: // liga LED
+            estado_definir_ligado(true);
+            printf("Requisição: led ligado\n\n");
+            break;
+        case CMD_LED_DESLIGAR: // desliga LED
+            estado_definir_ligado(false);
+            printf("Requisição: led desligado\n\n");
+            break;
+        case CMD_COR: // altera cor
+            estado_definir_cor((Cor)comando.valor);
+            printf("Requisição: led %s ligado\n\n", nomes_cores[comando.valor]);
+            break;
+        case CMD_ALARME_DESLIGAR: // desliga alarme
+            estado_definir_emergencia(false);
+            printf("Requisição: alarme desligado\n\n");
+            break;
+    }
 }
 
-// processa requisições HTTP
-void processar_requisicao(char **requisicao) {
-    if (strstr(*requisicao, "GET /led_on")) { // verifica requisição para ligar LED
-        led_ligado = true; // ativa LED
-    } else if (strstr(*requisicao, "GET /led_off")) { // verifica requisição para desligar LED
-        led_ligado = false; // desativa LED
-    } else if (strstr(*requisicao, "GET /color_red")) { // verifica requisição para cor vermelha
-        cor_atual = VERMELHO; // define cor como vermelho
-    } else if (strstr(*requisicao, "GET /color_green")) { // verifica requisição para cor verde
-        cor_atual = VERDE; // define cor como verde
-    } else if (strstr(*requisicao, "GET /color_blue")) { // verifica requisição para cor azul
-        cor_atual = AZUL; // edfine cor como azul
-    } else if (strstr(*requisicao, "GET /color_yellow")) { // verifica requisição para cor amarela
-        cor_atual = AMARELO; // define cor como amarelo
-    } else if (strstr(*requisicao, "GET /color_cyan")) { // verifica requisição para cor ciano
-        cor_atual = CIANO; // define cor como ciano
-    } else if (strstr(*requisicao, "GET /color_lilas")) { // verifica requisição para cor lilás
-        cor_atual = LILAS; // define cor como lilás
-    } else if (strstr(*requisicao, "GET /alarm_off")) { // verifica requisição para desligar alarme
-        emergencia = false; // desativa emergência
+// aplica comando a uma visão do estado (usado pela rede para responder antes do loop principal)
+void projetar_comando(visao_painel_t *visao, comando_t comando) {
+    switch (comando.tipo) {
+        case CMD_LED_LIGAR: visao->led_ligado = true; break; // LED ligado
+        case CMD_LED_DESLIGAR: visao->led_ligado = false; break; // LED desligado
+        case CMD_COR: visao->cor = (Cor)comando.valor; break; // nova cor
+        case CMD_ALARME_DESLIGAR: visao->emergencia = false; break; // emergência desligada
     }
 }
 
-// callback de recebimento de dados TCP
-static err_t tcp_server_recv(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, err_t err) {
-    if (!p) { // se não há dados (conexão fechada)
-        tcp_close(tpcb); // fecha conexão
-        tcp_recv(tpcb, NULL); // remove callback de recebimento
-        return ERR_OK; // reetorna sucesso
+// publica o estado atual para os callbacks de rede
+void publicar_visao(void) {
+    uint8_t proxima = visao_ativa ^ 1; // escreve no buffer que a rede não está lendo
+    const estado_t *estado = estado_atual(); // estado do loop principal
+    visoes[proxima] = (visao_painel_t){estado->led_ligado, estado->cor, estado->emergencia, estado->temperatura, comandos_aplicados};
+    __dmb(); // conteúdo visível antes da troca de índice
+    visao_ativa = proxima; // troca atômica do buffer publicado
+}
+
+// estado usado para responder requisições (contexto de rede)
+static visao_painel_t visao_rede(void) {
+    const visao_painel_t *publicada = &visoes[visao_ativa]; // última visão publicada
+    if (publicada->comandos_aplicados == comandos_enviados) { // loop principal já aplicou tudo
+        return *publicada; // estado publicado está completo
+    }
+    return visao_projetada; // ainda há comandos na fila
+}
+
+// enfileira o comando de uma rota para o loop principal e projeta seu efeito na página (contexto de rede)
+static const char *cgi_comando(int indice, int num_parametros, char *parametros[], char *valores[]) {
+    comando_t comando = rotas_comando[indice].comando; // comando da rota acessada
+    visao_painel_t visao = visao_rede(); // estado atual visto pela rede
+    if (fila_comandos_enviar(&fila_rede, comando)) { // fila cheia: página mostra o estado sem o comando
+        projetar_comando(&visao, comando); // página já reflete o comando
+        visao_projetada = visao; // guarda projeção até o loop principal alcançar
+        comandos_enviados++; // conta comando enfileirado
+        energia_evento(ORIGEM_HTTP); // acorda o loop e mede até o comando ser aplicado
     }
+    return "/index.shtml"; // responde com o painel atualizado
+}
 
-    char *requisicao = (char *)malloc(p->len + 1); // aloca memória para a requisição
-    memcpy(requisicao, p->payload, p->len); // copia dados da requisição
-    requisicao[p->len] = '\0'; // adiciona terminador nulo à string
-
-    // traduz a requisição para mensagem 
-    if (strstr(requisicao, "GET /led_on")) { // requisição para ligar LED
-        printf("Requisição: led ligado\n\n"); // loga ação no Serial Monitor
-    } else if (strstr(requisicao, "GET /led_off")) { // requisição para desligar LED
-        printf("Requisição: led desligado\n\n"); // loga ação
-    } else if (strstr(requisicao, "GET /color_red")) { // requisição para cor vermelha
-        printf("Requisição: led vermelho ligado\n\n"); // loga ação
-    } else if (strstr(requisicao, "GET /color_green")) { // requisição para cor verde
-        printf("Requisição: led verde ligado\n\n"); // loga ação
-    } else if (strstr(requisicao, "GET /color_blue")) { // requisição para cor azul
-        printf("Requisição: led azul ligado\n\n"); // loga ação
-    } else if (strstr(requisicao, "GET /color_yellow")) { // requisição para cor amarela
-        printf("Requisição: led amarelo ligado\n\n"); // loga ação
-    } else if (strstr(requisicao, "GET /color_cyan")) { // requisição para cor ciano
-        printf("Requisição: led ciano ligado\n\n"); // loga ação
-    } else if (strstr(requisicao, "GET /color_lilas")) { // requisição para cor lilás
-        printf("Requisição: led lilás ligado\n\n"); // loga ação
-    } else if (strstr(requisicao, "GET /alarm_off")) { // requisição para desligar alarme
-        printf("Requisição: alarme desligado\n\n"); // loga ação
+// preenche as tags SSI da página com o estado visto pela rede (contexto de rede)
+static u16_t ssi_painel(int indice, char *insercao, int tamanho) {
+    static const char *nomes_cores[] = {"Vermelho", "Verde", "Azul", "Amarelo", "Ciano", "Lilás"}; // nomes exibidos
+    visao_painel_t visao = visao_rede(); // estado atual visto pela rede
+    energia_atividade_rede(); // página servida: há cliente, mantém o modo ativo
+    int escritos = 0; // caracteres inseridos no lugar da tag
+    switch (indice) {
+        case 0: // <!--#led-->
+            escritos = snprintf(insercao, tamanho, "%s", visao.led_ligado ? "LIGADO" : "DESLIGADO");
+            break;
+        case 1: // <!--#cor-->
+            escritos = snprintf(insercao, tamanho, "%s", nomes_cores[visao.cor]);
+            break;
+        case 2: // <!--#temp-->
+            escritos = snprintf(insercao, tamanho, "%.2f", visao.temperatura);
+            break;
+        case 3: // <!--#emerg-->
+            escritos = snprintf(insercao, tamanho, "%s", visao.emergencia ? "LIGADA" : "DESLIGADA");
+            break;
     }
+    return (u16_t)(escritos < tamanho ? escritos : tamanho - 1); // snprintf pode ter truncado
+}
 
-    processar_requisicao(&requisicao); // processa a requisição para atualizar estados
-    float temperatura = ler_temperatura(); // lê temperatura atual para exibir no HTML
-
-    char html[1536]; // buffer para página HTML (máximo 1536 bytes)
-    snprintf(html, sizeof(html), // formata página HTML com estado atual
-             "HTTP/1.1 200 OK\r\n" // status HTTP 200 
-             "Content-Type: text/html\r\n" // tipo de conteúdo: HTML
-             "\r\n" // fim do cabeçalho HTTP
-             "<!DOCTYPE html>" // declaração DOCTYPE para HTML5
-             "<html>" // início do documento HTML
-             "<head>" // cabeçalho HTML
-             "<meta charset=\"UTF-8\">" // define codificação UTF-8 para acentos
-             "<title>Painel Casa Inteligente</title>" // título da página
-             "<style>" // estilos CSS
-             "body{font-family:Arial;text-align:center;margin:10px;background-color:#b5e5fb}" // estiliza corpo (fonte, centralizado, fundo azul claro)
-             "h1{font-size:40px}" // título com fonte 40px
-             "button{font-size:32px;margin:5px;padding:5px}" // botões com fonte 32px e margens
-             ".s{font-size:32px;margin:5px}" // classe .s para textos com fonte 32px
-             "</style>" // fim dos estilos
-             "</head>" // fim do cabeçalho
-             "<body>" // início do corpo HTML
-             "<h1>Painel Casa Inteligente</h1>" // título principal
-             "<form action=\"./led_on\"><button>Ligar LED</button></form>" // botão para ligar LED
-             "<form action=\"./led_off\"><button>Desligar LED</button></form>" // botão para desligar LED
-             "<form action=\"./color_red\"><button>Vermelho</button></form>" // botão para cor vermelha
-             "<form action=\"./color_green\"><button>Verde</button></form>" // botão para cor verde
-             "<form action=\"./color_blue\"><button>Azul</button></form>" // botão para cor azul
-             "<form action=\"./color_yellow\"><button>Amarelo</button></form>" // botão para cor amarela
-             "<form action=\"./color_cyan\"><button>Ciano</button></form>" // botão para cor ciano
-             "<form action=\"./color_lilas\"><button>Lilás</button></form>" // botão para cor lilás
-             "<form action=\"./alarm_off\"><button>Desligar Alarme</button></form>" // botão para desligar alarme
-             "<p class=s>LED: %s</p>" // exibe estado do LED (LIGADO/DESLIGADO)
-             "<p class=s>Cor: %s</p>" // exibe cor atual
-             "<p class=s>Temperatura: %.2fC</p>" // exibe temperatura
-             "<p class=s>Emergência: %s</p>" // exibe estado da emergência (LIGADA/DESLIGADA)
-             "</body>" // fim do corpo
-             "</html>", // fim do documento HTML
-             led_ligado ? "LIGADO" : "DESLIGADO", // estado do LED
-             cor_atual == VERMELHO ? "Vermelho" : // nome da cor atual
-             cor_atual == VERDE ? "Verde" :
-             cor_atual == AZUL ? "Azul" :
-             cor_atual == AMARELO ? "Amarelo" :
-             cor_atual == CIANO ? "Ciano" : "Lilás",
-             temperatura, // valor da temperatura
-             emergencia ? "LIGADA" : "DESLIGADA"); // estado da emergência
-
-    tcp_write(tpcb, html, strlen(html), TCP_WRITE_FLAG_COPY); // envia página HTML ao cliente
-    tcp_output(tpcb); // força envio dos dados
-    free(requisicao); // libera memória alocada para a requisição
-    pbuf_free(p); // libera buffer da requisição
-    return ERR_OK; // retorna sucesso
+// cria os widgets do display OLED
+void configurar_tela(void) {
+    tela_init(&tela, &disp); // tela sobre o display OLED
+    widget_icone(&w_alerta, 2, 2, icone_alerta); // ícone de emergência (apagado)
+    widget_valor(&w_temperatura, 20, 2, 13); // "TEMP: 00.00C" na linha 1
+    widget_valor(&w_emergencia, 2, 14, 15); // "EMERGENCIA: OFF" na linha 2
+    widget_sparkline(&w_historico, 2, 25, 124, 11, historico_temperatura, HISTORICO_AMOSTRAS, 100); // gráfico, escala mínima de 1°C
+    widget_rotulo(&w_rotulo_ip, 6, 38, "IP P/ CONEXAO:"); // rótulo na linha 3
+    widget_valor(&w_ip, 6, 50, 15); // IP na linha 4
+    widget_barra(&w_progresso, 6, 50, 116, 8); // progresso da conexão, no lugar do IP
+    widget_texto_definir(&w_ip, "N/A"); // sem IP até conectar
+    tela_adicionar(&tela, &w_alerta);
+    tela_adicionar(&tela, &w_temperatura);
+    tela_adicionar(&tela, &w_emergencia);
+    tela_adicionar(&tela, &w_historico);
+    tela_adicionar(&tela, &w_rotulo_ip);
+    tela_adicionar(&tela, &w_ip);
+    tela_adicionar(&tela, &w_progresso);
+    exibir_status_rede("INICIANDO...", 5); // Wi-Fi ainda não iniciado
 }
 
-// atualiza display OLED
+// atualiza widgets do OLED (cada widget só é redesenhado se seu valor mudou)
 void atualizar_display(void) {
     char temp_str[20]; // buffer para string da temperatura
-    char ip_str[16]; // buffer para string do endereço IP
-    ssd1306_fill(&disp, 0); // Limpa o buffer do display 
-    snprintf(temp_str, sizeof(temp_str), "TEMP: %.2fC", ler_temperatura()); 
-    snprintf(ip_str, sizeof(ip_str), "%s", netif_default ? ipaddr_ntoa(&netif_default->ip_addr) : "N/A"); 
-    ssd1306_draw_string(&disp, temp_str, 20, 2); // exibe temperatura na linha 1 
-    ssd1306_draw_string(&disp, emergencia ? "EMERGENCIA: ON" : "EMERGENCIA: OFF", 2, 18); // exibe emergência na linha 2 
-    ssd1306_draw_string(&disp, "IP P/ CONEXAO:", 6, 34); // exibe texto na linha 3 
-    ssd1306_draw_string(&disp, ip_str, 6, 50); // exibe IP na linha 4 
-    ssd1306_send_data(&disp); // envia buffer ao display OLED
-}
\ No newline at end of file
+    snprintf(temp_str, sizeof(temp_str), "TEMP: %.2fC", estado_atual()->temperatura); // última leitura do loop principal
+    widget_texto_definir(&w_temperatura, temp_str); // exibe temperatura na linha 1
+    widget_texto_definir(&w_emergencia, estado_atual()->emergencia ? "EMERGENCIA: ON" : "EMERGENCIA: OFF"); // exibe emergência na linha 2
+    widget_icone_definir(&w_alerta, estado_atual()->emergencia); // ícone acompanha a emergência
+}
+
+// saída LED RGB: cor atual se ligado, apagado em emergência
+static void render_led_rgb(const estado_t *estado, uint32_t campos) {
+    configurar_led_rgb(estado->cor, estado->led_ligado && !estado->emergencia); // fade até a nova cor
+}
+
+// saída matriz: "!" em emergência, "V" na cor atual se ligado
+static void render_matriz(const estado_t *estado, uint32_t campos) {
+    if (estado->emergencia) { // se emergência ativa
+        configurar_matriz(padrao_exclamacao, 32, 0, 0); // exibe padrão "!" em vermelho
+    } else if (estado->led_ligado) { // se LED ligado e sem emergência
+        uint8_t r = 0, g = 0, b = 0; // inicializa componentes RGB
+        switch (estado->cor) { // define valores RGB com base na cor atual
+            case VERMELHO: r = 32; break; // Vermelho
+            case VERDE: g = 32; break; // Verde
+            case AZUL: b = 32; break; // Azul
+            case AMARELO: r = 32; g = 32; break; // Amarelo
+            case CIANO: g = 32; b = 32; break; // Ciano
+            case LILAS: r = 32; b = 32; break; // Lilás
+        }
+        configurar_matriz(padrao_V, r, g, b); // exibe padrão "V" na cor atual
+    } else { // se LED desligado
+        configurar_matriz(padrao_V, 0, 0, 0); // desliga matriz 
+    }
+}
+
+// saída buzzer: alarme intermitente enquanto durar a emergência
+static void render_buzzer(const estado_t *estado, uint32_t campos) {
+    if (estado->emergencia) { // se emergência ativa
+        buzzer_padrao(alarme_emergencia, count_of(alarme_emergencia), true); // inicia alarme intermitente
+    } else { // emergência desativada
+        buzzer_parar(); // desliga buzzer
+    }
+}
+
+// saída OLED: atualiza os widgets quando temperatura ou emergência mudam
+static void render_oled(const estado_t *estado, uint32_t campos) {
+    atualizar_display(); // envio ao display fica com tela_enviar
+}
+
+// saída HTTP: publica o novo estado para os callbacks de rede
+static void render_rede(const estado_t *estado, uint32_t campos) {
+    publicar_visao(); // clientes passam a ver o novo estado
+}
+
+// saída telemetria: temperatura e mudanças de estado entram no próximo lote UDP
+static void render_telemetria(const estado_t *estado, uint32_t campos) {
+    uint32_t agora = to_ms_since_boot(get_absolute_time()); // instante da mudança
+    if (campos & CAMPO_TEMPERATURA) { // nova leitura de temperatura
+        telemetria_temperatura(agora, estado->temperatura);
+    }
+    telemetria_estado(agora, estado, campos); // LED, cor e emergência alterados
+}
+
+// saída flash: cor e LED viram configuração pendente (gravada em lote por config_painel_persistir)
+static void render_config(const estado_t *estado, uint32_t campos) {
+    config_painel_definir_cor(estado->cor); // valor igual ao gravado não gera registro
+    config_painel_definir_ligado(estado->led_ligado);
+}
@@ -0,0 +1,299 @@
+// Teste no computador do formato de lib/config_log sobre uma flash simulada em
+// RAM, com quedas de energia no meio das gravações.
+//
+//   gcc -std=c11 -Wall -Ilib -o test_config_log test/test_config_log.c lib/config_log.c && ./test_config_log
+//
+// ou pelo CMake de test/ (compilador do computador, não o do Pico):
+//
+//   cmake -S test -B build_test && cmake --build build_test && ctest --test-dir build_test
+
+#include <stdio.h>
+#include <string.h>
+#include "config_log.h"
+
+#define SETOR 4096
+#define PAGINA 256
+#define SETORES 4
+#define TEXTO_BYTES 32
+
+typedef struct {
+    uint8_t dados[SETORES * SETOR];
+    uint32_t apagamentos[SETORES];
+    int operacoes;           // apagamentos e programações desde o início do teste
+    int corte;               // operação em que a energia cai (-1: nunca)
+    uint32_t bytes_rasgados; // quanto da operação do corte chega à flash
+} flash_sim_t;
+
+static int falhas;
+
+#define VERIFICAR(condicao)                                                        \
+    do {                                                                           \
+        if (!(condicao)) {                                                         \
+            printf("%s:%d: falhou: %s\n", __FILE__, __LINE__, #condicao);          \
+            falhas++;                                                              \
+        }                                                                          \
+    } while (0)
+
+// bytes da operação que chegam à flash: todos antes do corte, parte no corte e nenhum depois
+static uint32_t com_energia(flash_sim_t *sim, uint32_t tamanho) {
+    int operacao = sim->operacoes++;
+    if (sim->corte < 0 || operacao < sim->corte) {
+        return tamanho;
+    }
+    if (operacao == sim->corte) {
+        return sim->bytes_rasgados < tamanho ? sim->bytes_rasgados : tamanho;
+    }
+    return 0;
+}
+
+static const uint8_t *ler_sim(void *ctx, uint32_t deslocamento) {
+    return ((flash_sim_t *)ctx)->dados + deslocamento;
+}
+
+static void apagar_sim(void *ctx, uint32_t deslocamento) {
+    flash_sim_t *sim = ctx;
+    VERIFICAR(deslocamento % SETOR == 0);
+    uint32_t apagados = com_energia(sim, SETOR);
+    memset(sim->dados + deslocamento, 0xFF, apagados);
+    if (apagados == SETOR) {
+        sim->apagamentos[deslocamento / SETOR]++;
+    }
+}
+
+static void programar_sim(void *ctx, uint32_t deslocamento, const uint8_t *dados, uint32_t tamanho) {
+    flash_sim_t *sim = ctx;
+    VERIFICAR(deslocamento % PAGINA == 0 && tamanho == PAGINA);
+    uint32_t programados = com_energia(sim, tamanho);
+    for (uint32_t i = 0; i < programados; i++) {
+        sim->dados[deslocamento + i] &= dados[i]; // programar só leva bits de 1 para 0
+    }
+}
+
+static flash_sim_t sim;
+static memoria_flash_t memoria;
+
+static void flash_nova(void) {
+    memset(&sim, 0, sizeof(sim));
+    memset(sim.dados, 0xFF, sizeof(sim.dados));
+    sim.corte = -1;
+    memoria = (memoria_flash_t){SETOR, PAGINA, SETORES, ler_sim, apagar_sim, programar_sim, &sim};
+}
+
+static uint32_t ler_u32(const config_log_t *log, uint8_t chave) {
+    uint32_t valor = 0xDEADBEEF;
+    VERIFICAR(config_log_ler(log, chave, &valor, sizeof(valor)) == sizeof(valor));
+    return valor;
+}
+
+static void definir_u32(config_log_t *log, uint8_t chave, uint32_t valor) {
+    config_log_definir(log, chave, &valor, sizeof(valor));
+}
+
+// chave 1: texto cujo conteúdo acompanha o contador da chave 0
+static void definir_texto(config_log_t *log, uint8_t chave, uint8_t marca) {
+    uint8_t texto[TEXTO_BYTES];
+    memset(texto, marca, sizeof(texto));
+    config_log_definir(log, chave, texto, sizeof(texto));
+}
+
+static bool texto_igual(const config_log_t *log, uint8_t chave, uint8_t marca) {
+    uint8_t texto[TEXTO_BYTES], esperado[TEXTO_BYTES];
+    memset(esperado, marca, sizeof(esperado));
+    return config_log_ler(log, chave, texto, sizeof(texto)) == TEXTO_BYTES &&
+           memcmp(texto, esperado, sizeof(texto)) == 0;
+}
+
+// grava o par contador/texto de uma vez, como um lote
+static bool gravar_par(config_log_t *log, uint32_t valor) {
+    definir_u32(log, 0, valor);
+    definir_texto(log, 1, (uint8_t)valor);
+    return config_log_gravar(log);
+}
+
+static void teste_ida_e_volta(void) {
+    flash_nova();
+    static config_log_t log, relido;
+    config_log_abrir(&log, &memoria);
+    uint8_t byte;
+    VERIFICAR(log.setor_ativo == -1);
+    VERIFICAR(config_log_ler(&log, 0, &byte, 1) == -1);
+
+    uint8_t maximo[CONFIG_VALOR_MAX];
+    for (int i = 0; i < CONFIG_VALOR_MAX; i++) {
+        maximo[i] = (uint8_t)(i * 7);
+    }
+    const char *ssid = "Apartamento 01";
+    definir_u32(&log, 0, 1234);
+    config_log_definir(&log, 3, ssid, (uint8_t)strlen(ssid));
+    config_log_definir(&log, CONFIG_MAX_CHAVES - 1, maximo, sizeof(maximo));
+    VERIFICAR(!config_log_definir(&log, CONFIG_MAX_CHAVES, &byte, 1)); // chave fora da faixa
+    VERIFICAR(config_log_gravar(&log));
+    VERIFICAR(!config_log_pendente(&log));
+
+    config_log_abrir(&relido, &memoria);
+    VERIFICAR(ler_u32(&relido, 0) == 1234);
+    char texto[CONFIG_VALOR_MAX + 1] = {0};
+    VERIFICAR(config_log_ler(&relido, 3, texto, CONFIG_VALOR_MAX) == (int)strlen(ssid));
+    VERIFICAR(strcmp(texto, ssid) == 0);
+    uint8_t lido[CONFIG_VALOR_MAX];
+    VERIFICAR(config_log_ler(&relido, CONFIG_MAX_CHAVES - 1, lido, sizeof(lido)) == CONFIG_VALOR_MAX);
+    VERIFICAR(memcmp(lido, maximo, sizeof(maximo)) == 0);
+    VERIFICAR(config_log_ler(&relido, 3, texto, 4) == 4); // destino menor trunca
+    VERIFICAR(config_log_tamanho(&relido, 3) == (int)strlen(ssid)); // o tamanho guardado não
+    VERIFICAR(config_log_tamanho(&relido, 1) == -1);
+    VERIFICAR(config_log_ler(&relido, 1, &byte, 1) == -1);
+
+    uint32_t mesmo = 1234;
+    VERIFICAR(!config_log_definir(&relido, 0, &mesmo, sizeof(mesmo))); // valor igual não fica pendente
+    VERIFICAR(!config_log_pendente(&relido));
+}
+
+static void teste_coalescencia(void) {
+    flash_nova();
+    static config_log_t log, relido;
+    config_log_abrir(&log, &memoria);
+    for (uint32_t i = 0; i < 100; i++) {
+        definir_u32(&log, 0, i);
+        definir_u32(&log, 1, i * 2);
+    }
+    VERIFICAR(config_log_gravar(&log));
+    config_log_abrir(&relido, &memoria);
+    VERIFICAR(relido.registros_lidos == 2); // um registro por chave no lote
+    VERIFICAR(ler_u32(&relido, 0) == 99);
+    VERIFICAR(ler_u32(&relido, 1) == 198);
+
+    for (uint32_t i = 0; i < 50; i++) {
+        definir_u32(&log, 0, 1000 + i);
+    }
+    VERIFICAR(config_log_gravar(&log));
+    VERIFICAR(log.gravacoes == 2);
+    config_log_abrir(&relido, &memoria);
+    VERIFICAR(relido.registros_lidos == 3);
+    VERIFICAR(ler_u32(&relido, 0) == 1049);
+    VERIFICAR(ler_u32(&relido, 1) == 198);
+}
+
+static void teste_rodizio(void) {
+    flash_nova();
+    static config_log_t log, relido;
+    config_log_abrir(&log, &memoria);
+    bool visitado[SETORES] = {false};
+    for (uint32_t i = 0; i < 1000; i++) {
+        VERIFICAR(gravar_par(&log, i));
+        visitado[log.setor_ativo] = true;
+        if (i % 97 == 0) {
+            config_log_abrir(&relido, &memoria);
+            VERIFICAR(relido.setor_ativo == log.setor_ativo);
+            VERIFICAR(ler_u32(&relido, 0) == i);
+            VERIFICAR(texto_igual(&relido, 1, (uint8_t)i));
+        }
+    }
+    VERIFICAR(log.compactacoes >= 2 * SETORES);
+    uint32_t menor = sim.apagamentos[0], maior = sim.apagamentos[0];
+    for (int s = 0; s < SETORES; s++) {
+        VERIFICAR(visitado[s]);
+        menor = sim.apagamentos[s] < menor ? sim.apagamentos[s] : menor;
+        maior = sim.apagamentos[s] > maior ? sim.apagamentos[s] : maior;
+    }
+    VERIFICAR(maior - menor <= 1); // desgaste distribuído
+}
+
+static void teste_registro_rasgado(void) {
+    flash_nova();
+    static config_log_t log, relido;
+    config_log_abrir(&log, &memoria);
+    definir_u32(&log, 0, 1);
+    definir_u32(&log, 1, 2);
+    VERIFICAR(config_log_gravar(&log));
+
+    // queda no meio do registro acrescentado: chave e tamanho gravados, CRC pela metade
+    sim.corte = sim.operacoes;
+    sim.bytes_rasgados = log.livre % PAGINA + 3;
+    definir_u32(&log, 0, 3);
+    config_log_gravar(&log);
+    sim.corte = -1;
+
+    config_log_abrir(&relido, &memoria);
+    VERIFICAR(relido.compactar);
+    VERIFICAR(ler_u32(&relido, 0) == 1);
+    VERIFICAR(ler_u32(&relido, 1) == 2);
+
+    int32_t setor_anterior = relido.setor_ativo;
+    definir_u32(&relido, 0, 5);
+    VERIFICAR(config_log_gravar(&relido));
+    VERIFICAR(relido.setor_ativo != setor_anterior); // não acrescenta depois do registro danificado
+    VERIFICAR(relido.compactacoes == 1);
+
+    config_log_abrir(&relido, &memoria);
+    VERIFICAR(!relido.compactar);
+    VERIFICAR(ler_u32(&relido, 0) == 5);
+    VERIFICAR(ler_u32(&relido, 1) == 2);
+}
+
+// passa por todos os setores e para com o ativo quase cheio: o próximo par compacta
+static uint32_t preparar_compactacao(config_log_t *log) {
+    flash_nova();
+    config_log_abrir(log, &memoria);
+    uint32_t valor = 0;
+    uint32_t tamanho_par = (4 + 4) + (4 + TEXTO_BYTES);
+    while (log->compactacoes <= SETORES || log->livre + tamanho_par <= SETOR) {
+        VERIFICAR(gravar_par(log, valor++));
+    }
+    return valor - 1;
+}
+
+static void teste_queda_na_compactacao(void) {
+    static config_log_t log, relido;
+    const uint32_t novo = 0xC0FFEE;
+
+    // operações de uma compactação completa; o cabeçalho é a última
+    preparar_compactacao(&log);
+    uint32_t compactacoes = log.compactacoes;
+    int inicio = sim.operacoes;
+    VERIFICAR(gravar_par(&log, novo));
+    VERIFICAR(log.compactacoes == compactacoes + 1);
+    int total = sim.operacoes - inicio;
+    int operacao_cabecalho = total - 1;
+
+    const uint32_t rasgados[] = {0, 6, PAGINA / 2}; // nada, cabeçalho incompleto, página pela metade
+    int casos = 0;
+    for (int corte = 0; corte <= total; corte++) {
+        for (size_t r = 0; r < sizeof(rasgados) / sizeof(rasgados[0]); r++) {
+            uint32_t antigo = preparar_compactacao(&log);
+            sim.corte = sim.operacoes + corte;
+            sim.bytes_rasgados = rasgados[r];
+            gravar_par(&log, novo);
+            sim.corte = -1; // energia volta: reinicia lendo a flash
+
+            config_log_abrir(&relido, &memoria);
+            bool cabecalho_completo = corte > operacao_cabecalho ||
+                                      (corte == operacao_cabecalho && rasgados[r] >= 12);
+            uint32_t esperado = cabecalho_completo ? novo : antigo;
+            VERIFICAR(ler_u32(&relido, 0) == esperado); // tudo ou nada
+            VERIFICAR(texto_igual(&relido, 1, (uint8_t)esperado));
+            VERIFICAR(!relido.compactar);
+
+            // o log continua utilizável depois da queda
+            VERIFICAR(gravar_par(&relido, novo + 1));
+            config_log_abrir(&relido, &memoria);
+            VERIFICAR(ler_u32(&relido, 0) == novo + 1);
+            VERIFICAR(texto_igual(&relido, 1, (uint8_t)(novo + 1)));
+            casos++;
+        }
+    }
+    VERIFICAR(casos == (total + 1) * 3);
+}
+
+int main(void) {
+    teste_ida_e_volta();
+    teste_coalescencia();
+    teste_rodizio();
+    teste_registro_rasgado();
+    teste_queda_na_compactacao();
+    if (falhas) {
+        printf("config_log: %d verificacoes falharam\n", falhas);
+        return 1;
+    }
+    printf("config_log: todos os testes passaram\n");
+    return 0;
+}
@@ -0,0 +1,73 @@
+#!/usr/bin/env python3
+# Coletor de telemetria para testes: recebe os lotes UDP do painel (formato
+# descrito em lib/telemetria.h), imprime os registros e conta lotes perdidos
+# pelas lacunas na sequência.
+#
+# Uso: python3 tools/coletor_telemetria.py [porta]   (padrão 5005)
+# No Serial Monitor do painel: coletor <ip deste computador>:5005
+
+import socket
+import struct
+import sys
+import time
+
+CABECALHO = struct.Struct("<2sBBII")  # 'PT', versão, quantidade, sequência, início do lote (ms)
+REGISTRO = struct.Struct("<BBHi")     # tipo, campo, ms desde o início, valor
+
+CORES = ["vermelho", "verde", "azul", "amarelo", "ciano", "lilas"]
+CAMPOS_LOOP = ["passadas", "maior_us", "media_us"]
+
+
+def descrever(tipo, campo, valor):
+    if tipo == 1:
+        return "temperatura %.2f C" % (valor / 100)
+    if tipo == 2:
+        cor = (valor >> 1) & 0x07
+        return "estado led=%s cor=%s emergencia=%s (campos 0x%x)" % (
+            "on" if valor & 1 else "off",
+            CORES[cor] if cor < len(CORES) else cor,
+            "on" if valor & 0x10 else "off",
+            campo,
+        )
+    if tipo == 3:
+        nome = CAMPOS_LOOP[campo] if campo < len(CAMPOS_LOOP) else campo
+        return "loop %s=%d" % (nome, valor)
+    return "tipo %d campo %d valor %d" % (tipo, campo, valor)
+
+
+def main():
+    porta = int(sys.argv[1]) if len(sys.argv) > 1 else 5005
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    sock.bind(("", porta))
+    print("Aguardando telemetria na porta UDP %d" % porta)
+
+    proxima = {}  # próxima sequência esperada por painel
+    recebidos = perdidos = 0
+    while True:
+        dados, origem = sock.recvfrom(2048)
+        if len(dados) < CABECALHO.size:
+            continue
+        magico, versao, quantidade, sequencia, inicio = CABECALHO.unpack_from(dados)
+        if magico != b"PT" or versao != 1 or len(dados) != CABECALHO.size + quantidade * REGISTRO.size:
+            print("%s: datagrama invalido (%d bytes)" % (origem[0], len(dados)))
+            continue
+
+        esperada = proxima.get(origem[0])
+        if esperada is not None and sequencia != esperada:
+            if sequencia > esperada:
+                perdidos += sequencia - esperada
+                print("%s: %d lote(s) perdido(s) antes de #%d" % (origem[0], sequencia - esperada, sequencia))
+            else:
+                print("%s: sequencia reiniciada em #%d (painel reiniciou?)" % (origem[0], sequencia))
+        proxima[origem[0]] = sequencia + 1
+        recebidos += 1
+
+        print("%s %s: lote #%d, %d registros, %d bytes (recebidos %d, perdidos %d)" % (
+            time.strftime("%H:%M:%S"), origem[0], sequencia, quantidade, len(dados), recebidos, perdidos))
+        for i in range(quantidade):
+            tipo, campo, atraso, valor = REGISTRO.unpack_from(dados, CABECALHO.size + i * REGISTRO.size)
+            print("  t=%8d ms  %s" % (inicio + atraso, descrever(tipo, campo, valor)))
+
+
+if __name__ == "__main__":
+    main()
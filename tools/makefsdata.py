@@ -0,0 +1,144 @@
+#!/usr/bin/env python3
+# Gera generated/fsdata_painel.c (sistema de arquivos do httpd do lwIP) a partir de web/.
+#
+# - Páginas .shtml passam pelo SSI do httpd e vão sem compressão; o httpd monta
+#   os cabeçalhos delas em tempo de execução.
+# - Os demais arquivos vão com os cabeçalhos HTTP já prontos na flash
+#   (Content-Length, Cache-Control e ETag) e, quando isso os reduz, comprimidos
+#   com gzip (Content-Encoding). O httpd não lê Accept-Encoding, então o gzip
+#   parte do princípio de que esses arquivos só são pedidos por navegadores
+#   (o CSS é carregado pela página); páginas de erro como o 404, que qualquer
+#   cliente pode receber, nunca são comprimidas.
+# - O ETag é o CRC32 do conteúdo. As referências a esses arquivos nas páginas
+#   ganham "?v=<etag>", então a URL muda quando o conteúdo muda e o navegador
+#   pode guardar a versão atual por um ano sem revalidar.
+#
+# Uso: python3 tools/makefsdata.py [destino]  (padrão generated/fsdata_painel.c;
+#      a saída é determinística)
+
+import gzip
+import os
+import sys
+import zlib
+
+RAIZ = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+ORIGEM = os.path.join(RAIZ, "web")
+DESTINO = os.path.join(RAIZ, "generated", "fsdata_painel.c")
+
+TIPOS = {
+    ".html": "text/html; charset=UTF-8",
+    ".shtml": "text/html; charset=UTF-8",
+    ".css": "text/css",
+    ".js": "application/javascript",
+    ".svg": "image/svg+xml",
+    ".ico": "image/x-icon",
+}
+CACHE_IMUTAVEL = "public, max-age=31536000, immutable"
+
+
+def etag(conteudo):
+    return "%08x" % (zlib.crc32(conteudo) & 0xFFFFFFFF)
+
+
+def cabecalho(status, tipo, corpo, versao, comprimido):
+    linhas = [
+        "HTTP/1.0 %s" % status,
+        "Server: lwIP/pico",
+        "Content-Type: %s" % tipo,
+    ]
+    if comprimido:
+        linhas.append("Content-Encoding: gzip")
+    linhas.append("Content-Length: %d" % len(corpo))
+    if status.startswith("200"):
+        linhas.append("Cache-Control: %s" % CACHE_IMUTAVEL)
+        linhas.append('ETag: "%s"' % versao)
+    return ("\r\n".join(linhas) + "\r\n\r\n").encode("ascii")
+
+
+def identificador(nome):
+    return "".join(c if c.isalnum() else "_" for c in nome)
+
+
+def bytes_c(dados):
+    linhas = []
+    for i in range(0, len(dados), 16):
+        linhas.append(",".join("0x%02x" % b for b in dados[i:i + 16]) + ",")
+    return "\n".join(linhas)
+
+
+def main():
+    destino = sys.argv[1] if len(sys.argv) > 1 else DESTINO
+    arquivos = sorted(os.listdir(ORIGEM))
+    brutos = {}
+    for nome in arquivos:
+        with open(os.path.join(ORIGEM, nome), "rb") as f:
+            brutos[nome] = f.read()
+
+    versoes = {n: etag(c) for n, c in brutos.items() if not n.endswith(".shtml")}
+
+    entradas = []
+    for nome in arquivos:
+        extensao = os.path.splitext(nome)[1]
+        caminho = "/" + nome
+        conteudo = brutos[nome]
+        if extensao == ".shtml":
+            for outro, versao in versoes.items():
+                conteudo = conteudo.replace(('"/%s"' % outro).encode(),
+                                            ('"/%s?v=%s"' % (outro, versao)).encode())
+            dados = conteudo
+            flags = "FS_FILE_FLAGS_SSI"
+        else:
+            erro = nome.startswith("404.")
+            status = "404 File not found" if erro else "200 OK"
+            corpo = gzip.compress(conteudo, compresslevel=9, mtime=0)
+            comprimido = not erro and len(corpo) < len(conteudo)
+            if not comprimido:
+                corpo = conteudo
+            dados = cabecalho(status, TIPOS[extensao], corpo, versoes[nome], comprimido) + corpo
+            flags = "FS_FILE_FLAGS_HEADER_INCLUDED | FS_FILE_FLAGS_HEADER_PERSISTENT"
+        entradas.append((caminho, dados, flags, len(brutos[nome])))
+
+    saida = [
+        "// Gerado por tools/makefsdata.py a partir de web/; não edite à mão.",
+        "",
+        '#include "lwip/apps/fs.h"',
+        '#include "lwip/def.h"',
+        "",
+    ]
+    for caminho, dados, flags, original in entradas:
+        nome_c = identificador(caminho)
+        prefixo = caminho.encode() + b"\0"
+        saida.append("// %s: %d bytes na origem, %d na flash" % (caminho, original, len(dados)))
+        saida.append("static const unsigned char data_%s[] = {" % nome_c)
+        saida.append(bytes_c(prefixo))
+        saida.append(bytes_c(dados))
+        saida.append("};")
+        saida.append("")
+
+    anterior = "NULL"
+    for caminho, dados, flags, _ in entradas:
+        nome_c = identificador(caminho)
+        tamanho_nome = len(caminho) + 1
+        saida.append("static const struct fsdata_file file_%s[] = {{" % nome_c)
+        saida.append("    %s," % anterior)
+        saida.append("    data_%s," % nome_c)
+        saida.append("    data_%s + %d," % (nome_c, tamanho_nome))
+        saida.append("    sizeof(data_%s) - %d," % (nome_c, tamanho_nome))
+        saida.append("    %s," % flags)
+        saida.append("}};")
+        saida.append("")
+        anterior = "file_" + nome_c
+
+    saida.append("#define FS_ROOT %s" % anterior)
+    saida.append("#define FS_NUMFILES %d" % len(entradas))
+    saida.append("")
+
+    os.makedirs(os.path.dirname(os.path.abspath(destino)), exist_ok=True)
+    with open(destino, "w", newline="\n") as f:
+        f.write("\n".join(saida))
+    for caminho, dados, _, original in entradas:
+        print("%-14s %5d -> %5d bytes" % (caminho, original, len(dados)))
+
+
+if __name__ == "__main__":
+    main()